@@ -365,6 +365,11 @@ void can_set_register(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int a
 
 canfilter::canfilter()
   {
+  m_table[0].count = 0;
+  m_table[1].count = 0;
+  m_readers[0] = 0;
+  m_readers[1] = 0;
+  m_compiled = &m_table[0];
   }
 
 canfilter::~canfilter()
@@ -379,6 +384,7 @@ void canfilter::ClearFilters()
     delete filter;
     }
   m_filters.clear();
+  Compile();
   }
 
 void canfilter::AddFilter(uint8_t bus, uint32_t id_from, uint32_t id_to)
@@ -388,6 +394,7 @@ void canfilter::AddFilter(uint8_t bus, uint32_t id_from, uint32_t id_to)
   f->id_from = id_from;
   f->id_to = id_to;
   m_filters.push_back(f);
+  Compile();
   }
 
 void canfilter::AddFilter(const char* filterstring)
@@ -418,35 +425,118 @@ void canfilter::AddFilter(const char* filterstring)
 
 bool canfilter::RemoveFilter(uint8_t bus, uint32_t id_from, uint32_t id_to)
   {
-  for (CAN_filter_t* filter : m_filters)
+  for (CAN_filter_list_t::iterator it = m_filters.begin(); it != m_filters.end(); ++it)
     {
+    CAN_filter_t* filter = *it;
     if ((filter->bus == bus)&&
         (filter->id_from == id_from)&&
         (filter->id_to == id_to))
       {
+      m_filters.erase(it);
       delete filter;
+      Compile();
       return true;
       }
     }
   return false;
   }
 
+/**
+ * Compile: build the match table from the filter list
+ *  Ranges are collected per bus (including the filters for all buses), sorted
+ *  and merged, so IsFiltered() only needs a binary search on the frame's bus.
+ *  The table is built in the inactive buffer and then switched over, so a
+ *  concurrent IsFiltered() call never sees a partial table. Before reusing the
+ *  inactive buffer, we wait for IsFiltered() calls still reading it (i.e. that
+ *  started before the previous switch) to finish.
+ */
+void canfilter::Compile()
+  {
+  int tnum = (m_compiled == &m_table[0]) ? 1 : 0;
+  CAN_filter_table_t* table = &m_table[tnum];
+  while (m_readers[tnum] != 0)
+    vTaskDelay(1);
+
+  for (int i = 0; i <= CAN_MAXBUSES; i++)
+    {
+    CAN_filter_range_list_t& ranges = table->ranges[i];
+    char buskey = '0' + i;
+    ranges.clear();
+    for (CAN_filter_t* filter : m_filters)
+      {
+      if ((filter->bus)&&(filter->bus != buskey)) continue;
+      if (filter->id_from > filter->id_to) continue;
+      ranges.push_back({ filter->id_from, filter->id_to });
+      }
+    std::sort(ranges.begin(), ranges.end(),
+      [](const CAN_filter_range_t& a, const CAN_filter_range_t& b) { return a.id_from < b.id_from; });
+
+    // merge overlapping & adjacent ranges:
+    size_t n = 0;
+    for (size_t k = 0; k < ranges.size(); k++)
+      {
+      if (n > 0 && (ranges[n-1].id_to == UINT32_MAX || ranges[k].id_from <= ranges[n-1].id_to + 1))
+        {
+        if (ranges[k].id_to > ranges[n-1].id_to)
+          ranges[n-1].id_to = ranges[k].id_to;
+        }
+      else
+        {
+        ranges[n++] = ranges[k];
+        }
+      }
+    ranges.resize(n);
+    ranges.shrink_to_fit();
+    }
+
+  table->count = m_filters.size();
+  m_compiled = table;
+  }
+
+
+
 bool canfilter::IsFiltered(const CAN_frame_t* p_frame)
   {
-  if (m_filters.size() == 0) return true;
+  // Register as a reader of the current table, retry if it has been
+  // switched meanwhile (Compile() may already be rebuilding it):
+  const CAN_filter_table_t* table;
+  int tnum;
+  for (;;)
+    {
+    table = m_compiled;
+    tnum = (table == &m_table[0]) ? 0 : 1;
+    m_readers[tnum]++;
+    if (table == m_compiled) break;
+    m_readers[tnum]--;
+    }
+  bool res = IsFiltered(table, p_frame);
+  m_readers[tnum]--;
+  return res;
+  }
+
+bool canfilter::IsFiltered(const CAN_filter_table_t* table, const CAN_frame_t* p_frame)
+  {
+  if (table->count == 0) return true;
   if (! p_frame) return false;
 
-  char buskey = '0';
-  if (p_frame->origin) buskey = p_frame->origin->m_busnumber + '1';
+  int index = 0;
+  if (p_frame->origin) index = p_frame->origin->m_busnumber + 1;
+  if (index < 0 || index > CAN_MAXBUSES) return false;
 
-  for (CAN_filter_t* filter : m_filters)
+  // binary search for the last range starting at or below the ID:
+  const CAN_filter_range_list_t& ranges = table->ranges[index];
+  uint32_t id = p_frame->MsgID;
+  size_t lo = 0, hi = ranges.size();
+  while (lo < hi)
     {
-    if ((filter->bus)&&(filter->bus != buskey)) continue;
-    if ((p_frame->MsgID >= filter->id_from) && (p_frame->MsgID <= filter->id_to))
-      return true;
+    size_t mid = (lo + hi) / 2;
+    if (ranges[mid].id_from <= id)
+      lo = mid + 1;
+    else
+      hi = mid;
     }
 
-  return false;
+  return (lo > 0 && id <= ranges[lo-1].id_to);
   }
 
 bool canfilter::IsFiltered(canbus* bus)
@@ -871,9 +961,18 @@ void can::IncomingFrame(CAN_frame_t* p_frame)
   NotifyListeners(p_frame, false);
   }
 
-void can::RegisterListener(QueueHandle_t queue, bool txfeedback)
+/**
+ * RegisterListener: add a frame queue to the listeners
+ *  The optional filter is checked in the CanRx task before the frame is queued,
+ *  so listeners only interested in some IDs or buses don't get flooded. The
+ *  filter must stay valid (and unchanged) until the listener is deregistered.
+ */
+void can::RegisterListener(QueueHandle_t queue, bool txfeedback, canfilter* filter)
   {
-  m_listeners[queue] = txfeedback;
+  CanListener_t listener;
+  listener.txfeedback = txfeedback;
+  listener.filter = filter;
+  m_listeners[queue] = listener;
   }
 
 void can::DeregisterListener(QueueHandle_t queue)
@@ -887,8 +986,11 @@ void can::NotifyListeners(const CAN_frame_t* frame, bool tx)
   {
   for (CanListenerMap_t::iterator it = m_listeners.begin(); it != m_listeners.end(); ++it)
     {
-    if (!tx || (tx && it->second))
-      xQueueSend(it->first,frame,0);
+    if (tx && !it->second.txfeedback)
+      continue;
+    if (it->second.filter && !it->second.filter->IsFiltered(frame))
+      continue;
+    xQueueSend(it->first,frame,0);
     }
   }
 
@@ -952,7 +1054,8 @@ canbus::canbus(const char* name)
 
   using std::placeholders::_1;
   using std::placeholders::_2;
-  MyEvents.RegisterEvent(TAG, "ticker.10", std::bind(&canbus::BusTicker10, this, _1, _2));
+  using std::placeholders::_3;
+  MyEvents.RegisterEventId(TAG, "ticker.10", std::bind(&canbus::BusTicker10, this, _1, _2, _3));
   }
 
 canbus::~canbus()
@@ -1030,7 +1133,7 @@ dbcfile* canbus::GetDBC()
   return m_dbcfile;
   }
 
-void canbus::BusTicker10(std::string event, void* data)
+void canbus::BusTicker10(event_id_t id, const char* event, void* data)
   {
   if ((m_powermode==On)&&(StandardMetrics.ms_v_env_on->AsBool()))
     {
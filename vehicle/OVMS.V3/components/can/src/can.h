@@ -42,6 +42,8 @@
 #include <stdint.h>
 #include <functional>
 #include <list>
+#include <vector>
+#include <atomic>
 #include "pcp.h"
 #include <esp_err.h>
 #include "ovms_events.h"
@@ -209,6 +211,22 @@ typedef struct
 
 typedef std::list<CAN_filter_t*> CAN_filter_list_t;
 
+// Compiled filter: sorted & merged ID ranges per bus
+// (index 0 = frames without origin, 1..CAN_MAXBUSES = bus number + 1)
+typedef struct
+  {
+  uint32_t id_from;
+  uint32_t id_to;
+  } CAN_filter_range_t;
+
+typedef std::vector<CAN_filter_range_t> CAN_filter_range_list_t;
+
+typedef struct
+  {
+  size_t count;                                   // number of source filters
+  CAN_filter_range_list_t ranges[CAN_MAXBUSES+1];
+  } CAN_filter_table_t;
+
 class canfilter
   {
   public:
@@ -226,8 +244,15 @@ class canfilter
     bool IsFiltered(canbus* bus);
     std::string Info();
 
+  protected:
+    void Compile();
+    bool IsFiltered(const CAN_filter_table_t* table, const CAN_frame_t* p_frame);
+
   protected:
     CAN_filter_list_t m_filters;
+    CAN_filter_table_t m_table[2];                // double buffered for lock free matching
+    CAN_filter_table_t* volatile m_compiled;      // table currently in use
+    std::atomic<uint32_t> m_readers[2];           // IsFiltered() calls using m_table[n]
   };
 
 ////////////////////////////////////////////////////////////////////////
@@ -310,7 +335,7 @@ class canbus : public pcp, public InternalRamAllocated
 
   protected:
     virtual esp_err_t QueueWrite(const CAN_frame_t* p_frame, TickType_t maxqueuewait=0);
-    void BusTicker10(std::string event, void* data);
+    void BusTicker10(event_id_t id, const char* event, void* data);
 
   public:
     void LogFrame(CAN_log_type_t type, const CAN_frame_t* p_frame);
@@ -338,7 +363,12 @@ class canbus : public pcp, public InternalRamAllocated
 // can - the CAN system controller
 ////////////////////////////////////////////////////////////////////////
 
-typedef std::map<QueueHandle_t, bool> CanListenerMap_t;
+typedef struct
+  {
+  bool txfeedback;                  // also receive frames transmitted
+  canfilter* filter;                // optional bus/ID filter, NULL = all frames
+  } CanListener_t;
+typedef std::map<QueueHandle_t, CanListener_t> CanListenerMap_t;
 
 
 class CanFrameCallbackEntry
@@ -372,7 +402,7 @@ class can : public InternalRamAllocated
     QueueHandle_t m_rxqueue;
 
   public:
-    void RegisterListener(QueueHandle_t queue, bool txfeedback=false);
+    void RegisterListener(QueueHandle_t queue, bool txfeedback=false, canfilter* filter=NULL);
     void DeregisterListener(QueueHandle_t queue);
     void NotifyListeners(const CAN_frame_t* frame, bool tx);
 
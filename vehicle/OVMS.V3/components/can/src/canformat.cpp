@@ -91,9 +91,48 @@ const char* canformat::type()
   return m_type;
   }
 
+/**
+ * getbuf: format a message into the buffer
+ *  The buffer must provide at least CANFORMAT_MAXLEN bytes.
+ *  Returns the number of bytes written (0 = message not represented in the format).
+ */
+size_t canformat::getbuf(CAN_log_message_t* message, uint8_t* buffer, size_t size)
+  {
+  return 0;
+  }
+
+/**
+ * getbatch: append a series of messages to the buffer
+ *  Stops when the remaining buffer space drops below CANFORMAT_MAXLEN.
+ *  Returns the number of bytes written, the number of messages consumed
+ *  is returned in done.
+ */
+size_t canformat::getbatch(CAN_log_message_t* messages, int count, uint8_t* buffer, size_t size, int* done)
+  {
+  size_t len = 0;
+  int i;
+  for (i = 0; i < count && size - len >= CANFORMAT_MAXLEN; i++)
+    {
+    len += getbuf(&messages[i], buffer + len, size - len);
+    }
+  if (done) *done = i;
+  return len;
+  }
+
 std::string canformat::get(CAN_log_message_t* message)
   {
-  return std::string("");
+  char buf[CANFORMAT_MAXLEN];
+  size_t len = getbuf(message, (uint8_t*)buf, sizeof(buf));
+  return std::string(buf, len);
+  }
+
+/**
+ * getflush: output data buffered by the format (i.e. a partial block)
+ *  Call until it returns 0 before closing the output.
+ */
+size_t canformat::getflush(uint8_t* buffer, size_t size)
+  {
+  return 0;
   }
 
 std::string canformat::getheader(struct timeval *time)
@@ -106,6 +145,25 @@ size_t canformat::put(CAN_log_message_t* message, uint8_t *buffer, size_t len, v
   return 0;
   }
 
+/**
+ * putpending: amount of input buffered by the format, not yet processed
+ *  put() consumes input and processes buffered input in separate steps, a change of
+ *  this value tells the caller put() made progress without returning a message.
+ */
+size_t canformat::putpending()
+  {
+  return m_buf.UsedSpace();
+  }
+
+/**
+ * SetPutFilter: let the format skip messages not matching the filter / before start
+ *  This is optional, formats supporting an index can use it to skip whole blocks.
+ *  The caller still needs to apply the filter to the messages returned by put().
+ */
+void canformat::SetPutFilter(canfilter* filter, const struct timeval* start)
+  {
+  }
+
 size_t canformat::Serve(uint8_t *buffer, size_t len, void* userdata)
   {
   if ((m_servediscarding)||(m_servemode == Discard))
@@ -38,6 +38,7 @@
 using namespace std;
 
 #define CANFORMAT_SERVE_BUFFERSIZE 1024
+#define CANFORMAT_MAXLEN 192              // Buffer space needed to format a single message
 
 typedef void (*canformat_put_write_fn)(uint8_t *buffer, size_t len, void* data);
 
@@ -54,11 +55,16 @@ class canformat
     const char* type();
 
   public: // Conversion from OVMS CAN log messages to specific format
-    virtual std::string get(CAN_log_message_t* message);
+    virtual size_t getbuf(CAN_log_message_t* message, uint8_t* buffer, size_t size);
+    size_t getbatch(CAN_log_message_t* messages, int count, uint8_t* buffer, size_t size, int* done=NULL);
+    std::string get(CAN_log_message_t* message);
+    virtual size_t getflush(uint8_t* buffer, size_t size);
     virtual std::string getheader(struct timeval *time = NULL);
 
   public: // Conversion from specific format to OVMS CAN log messages
     virtual size_t put(CAN_log_message_t* message, uint8_t *buffer, size_t len, void* userdata=NULL);
+    virtual size_t putpending();
+    virtual void SetPutFilter(canfilter* filter, const struct timeval* start=NULL);
 
   private:
     const char* m_type;
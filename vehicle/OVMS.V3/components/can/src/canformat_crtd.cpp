@@ -28,6 +28,7 @@
 static const char *TAG = "canformat-crtd";
 
 #include <errno.h>
+#include <sys/param.h>
 #include "pcp.h"
 #include "canformat_crtd.h"
 #include "ovms_utils.h"
@@ -53,9 +54,10 @@ canformat_crtd::~canformat_crtd()
   {
   }
 
-std::string canformat_crtd::get(CAN_log_message_t* message)
+size_t canformat_crtd::getbuf(CAN_log_message_t* message, uint8_t* buffer, size_t size)
   {
-  char buf[CANFORMAT_CRTD_MAXLEN];
+  char *buf = (char*)buffer;
+  size_t len = MIN(size, CANFORMAT_CRTD_MAXLEN) - 1; // reserve space for newline
   char *p;
 
   char busnumber;
@@ -68,7 +70,7 @@ std::string canformat_crtd::get(CAN_log_message_t* message)
     {
     case CAN_LogFrame_RX:
     case CAN_LogFrame_TX:
-      snprintf(buf,sizeof(buf),"%ld.%06ld %c%c%s %0*X",
+      snprintf(buf,len,"%ld.%06ld %c%c%s %0*X",
         message->timestamp.tv_sec, message->timestamp.tv_usec,
         busnumber,
         (message->type == CAN_LogFrame_RX) ? 'R' : 'T',
@@ -86,7 +88,7 @@ std::string canformat_crtd::get(CAN_log_message_t* message)
 
     case CAN_LogFrame_TX_Queue:
     case CAN_LogFrame_TX_Fail:
-      snprintf(buf,sizeof(buf),"%ld.%06ld %cCER %s %c%s %0*X",
+      snprintf(buf,len,"%ld.%06ld %cCER %s %c%s %0*X",
         message->timestamp.tv_sec, message->timestamp.tv_usec,
         busnumber,
         GetCanLogTypeName(message->type),
@@ -105,7 +107,7 @@ std::string canformat_crtd::get(CAN_log_message_t* message)
 
     case CAN_LogStatus_Error:
     case CAN_LogStatus_Statistics:
-      snprintf(buf,sizeof(buf),
+      snprintf(buf,len,
         "%ld.%06ld %c%s %s intr=%d rxpkt=%d txpkt=%d errflags=%#x rxerr=%d txerr=%d"
         " rxovr=%d txovr=%d txdelay=%d txfail=%d wdgreset=%d errreset=%d",
         message->timestamp.tv_sec, message->timestamp.tv_usec,
@@ -122,7 +124,7 @@ std::string canformat_crtd::get(CAN_log_message_t* message)
     case CAN_LogInfo_Comment:
     case CAN_LogInfo_Config:
     case CAN_LogInfo_Event:
-      snprintf(buf,sizeof(buf),"%ld.%06ld %c%s %s %s",
+      snprintf(buf,len,"%ld.%06ld %c%s %s %s",
         message->timestamp.tv_sec, message->timestamp.tv_usec,
         busnumber,
         (message->type == CAN_LogInfo_Event) ? "CEV" : "CXX",
@@ -135,8 +137,10 @@ std::string canformat_crtd::get(CAN_log_message_t* message)
       break;
     }
 
-  strcat(buf,"\n");
-  return std::string(buf);
+  p = buf+strlen(buf);
+  *p++ = '\n';
+  *p = 0;
+  return p-buf;
   }
 
 std::string canformat_crtd::getheader(struct timeval *time)
@@ -62,9 +62,9 @@ canformat_gvret::~canformat_gvret()
   {
   }
 
-std::string canformat_gvret::get(CAN_log_message_t* message)
+size_t canformat_gvret::getbuf(CAN_log_message_t* message, uint8_t* buffer, size_t size)
   {
-  return std::string("");
+  return 0;
   }
 
 std::string canformat_gvret::getheader(struct timeval *time)
@@ -86,14 +86,14 @@ canformat_gvret_ascii::canformat_gvret_ascii(const char* type)
   {
   }
 
-std::string canformat_gvret_ascii::get(CAN_log_message_t* message)
+size_t canformat_gvret_ascii::getbuf(CAN_log_message_t* message, uint8_t* buffer, size_t size)
   {
-  char buf[CANFORMAT_GVRET_MAXLEN];
+  char *buf = (char*)buffer;
 
   if ((message->type != CAN_LogFrame_RX)&&
       (message->type != CAN_LogFrame_TX))
     {
-    return std::string("");
+    return 0;
     }
 
   char busnumber = (message->origin != NULL)?message->origin->m_busnumber + '0':'0';
@@ -108,7 +108,7 @@ std::string canformat_gvret_ascii::get(CAN_log_message_t* message)
       sprintf(buf+strlen(buf)," %02x", message->frame.data.u8[k]);
 
   strcat(buf,"\n");
-  return std::string(buf);
+  return strlen(buf);
   }
 
 size_t canformat_gvret_ascii::put(CAN_log_message_t* message, uint8_t *buffer, size_t len, void* userdata)
@@ -188,7 +188,7 @@ canformat_gvret_binary::canformat_gvret_binary(const char* type)
   {
   }
 
-std::string canformat_gvret_binary::get(CAN_log_message_t* message)
+size_t canformat_gvret_binary::getbuf(CAN_log_message_t* message, uint8_t* buffer, size_t size)
   {
   gvret_binary_frame_t frame;
   memset(&frame,0,sizeof(frame));
@@ -196,7 +196,7 @@ std::string canformat_gvret_binary::get(CAN_log_message_t* message)
   if ((message->type != CAN_LogFrame_RX)&&
       (message->type != CAN_LogFrame_TX))
     {
-    return std::string("");
+    return 0;
     }
 
   char busnumber = (message->origin != NULL)?message->origin->m_busnumber:0;
@@ -209,7 +209,9 @@ std::string canformat_gvret_binary::get(CAN_log_message_t* message)
   frame.lenbus = message->frame.FIR.B.DLC + (busnumber<<4);
   for (int k=0; k<message->frame.FIR.B.DLC; k++)
     frame.data[k] = message->frame.data.u8[k];
-  return std::string((const char*)&frame,12 + message->frame.FIR.B.DLC);
+  size_t len = 12 + message->frame.FIR.B.DLC;
+  memcpy(buffer, &frame, len);
+  return len;
   }
 
 size_t canformat_gvret_binary::put(CAN_log_message_t* message, uint8_t *buffer, size_t len, void* userdata)
@@ -60,14 +60,14 @@ canformat_lawricel::~canformat_lawricel()
   {
   }
 
-std::string canformat_lawricel::get(CAN_log_message_t* message)
+size_t canformat_lawricel::getbuf(CAN_log_message_t* message, uint8_t* buffer, size_t size)
   {
-  char buf[CANFORMAT_LAWRICEL_MAXLEN];
+  char *buf = (char*)buffer;
 
   if ((message->type != CAN_LogFrame_RX)&&
       (message->type != CAN_LogFrame_TX))
     {
-    return std::string("");
+    return 0;
     }
 
   if (message->frame.FIR.B.FF == CAN_frame_std)
@@ -84,7 +84,7 @@ std::string canformat_lawricel::get(CAN_log_message_t* message)
   sprintf(buf+strlen(buf),"%04lx", message->timestamp.tv_usec/1000);
 
   strcat(buf,"\n");
-  return std::string(buf);
+  return strlen(buf);
   }
 
 std::string canformat_lawricel::getheader(struct timeval *time)
@@ -53,13 +53,13 @@ canformat_pcap::~canformat_pcap()
   {
   }
 
-std::string canformat_pcap::get(CAN_log_message_t* message)
+size_t canformat_pcap::getbuf(CAN_log_message_t* message, uint8_t* buffer, size_t size)
   {
   pcaprec_can_t m;
 
   if (message->type != CAN_LogFrame_RX)
     {
-    return std::string("");
+    return 0;
     }
 
   memset(&m,0,sizeof(m));
@@ -77,7 +77,8 @@ std::string canformat_pcap::get(CAN_log_message_t* message)
 
   memcpy(m.data, message->frame.data.u8, message->frame.FIR.B.DLC);
 
-  return std::string((const char*)&m, sizeof(m));
+  memcpy(buffer, &m, sizeof(m));
+  return sizeof(m);
   }
 
 std::string canformat_pcap::getheader(struct timeval *time)
@@ -53,12 +53,13 @@ canformat_raw::~canformat_raw()
   {
   }
 
-std::string canformat_raw::get(CAN_log_message_t* message)
+size_t canformat_raw::getbuf(CAN_log_message_t* message, uint8_t* buffer, size_t size)
   {
   CAN_log_message_t raw;
   memcpy(&raw,message,sizeof(raw));
   raw.origin = (canbus*)raw.origin->m_busnumber;
-  return std::string((const char*)&raw,sizeof(CAN_log_message_t));
+  memcpy(buffer,&raw,sizeof(raw));
+  return sizeof(raw);
   }
 
 std::string canformat_raw::getheader(struct timeval *time)
@@ -0,0 +1,565 @@
+/*
+;    Project:       Open Vehicle Monitor System
+;    Module:        CAN dump compressed binary block format
+;    Date:          16th October 2026
+;
+;    (C) 2026       Open Vehicles
+;
+; Permission is hereby granted, free of charge, to any person obtaining a copy
+; of this software and associated documentation files (the "Software"), to deal
+; in the Software without restriction, including without limitation the rights
+; to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+; copies of the Software, and to permit persons to whom the Software is
+; furnished to do so, subject to the following conditions:
+;
+; The above copyright notice and this permission notice shall be included in
+; all copies or substantial portions of the Software.
+;
+; THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+; IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+; FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+; AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+; LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+; OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+; THE SOFTWARE.
+*/
+
+#include "ovms_log.h"
+static const char *TAG = "canformat-zlog";
+
+#include "canformat_zlog.h"
+
+#ifdef CONFIG_OVMS_SC_ZIP
+
+#include <errno.h>
+#include <sys/param.h>
+#include "ovms_malloc.h"
+#include "pcp.h"
+
+class OvmsCanFormatZLOGInit
+  {
+  public: OvmsCanFormatZLOGInit();
+} MyOvmsCanFormatZLOGInit  __attribute__ ((init_priority (4505)));
+
+OvmsCanFormatZLOGInit::OvmsCanFormatZLOGInit()
+  {
+  ESP_LOGI(TAG, "Registering CAN Format: ZLOG (4505)");
+
+  MyCanFormatFactory.RegisterCanFormat<canformat_zlog>("zlog");
+  }
+
+static voidpf zlog_zalloc(voidpf opaque, uInt items, uInt size)
+  {
+  return ExternalRamCalloc(items, size);
+  }
+
+static void zlog_zfree(voidpf opaque, voidpf address)
+  {
+  free(address);
+  }
+
+static inline uint8_t* zlog_put_varint(uint8_t* p, uint32_t val)
+  {
+  while (val >= 0x80)
+    {
+    *p++ = (val & 0x7f) | 0x80;
+    val >>= 7;
+    }
+  *p++ = val;
+  return p;
+  }
+
+static inline bool zlog_get_varint(const uint8_t* &p, const uint8_t* end, uint32_t &val)
+  {
+  val = 0;
+  for (int shift = 0; shift < 35 && p < end; shift += 7)
+    {
+    uint8_t b = *p++;
+    val |= (uint32_t)(b & 0x7f) << shift;
+    if ((b & 0x80) == 0) return true;
+    }
+  return false;
+  }
+
+canformat_zlog::canformat_zlog(const char* type)
+  : canformat(type)
+  {
+  memset(&m_zout, 0, sizeof(m_zout));
+  m_zout_init = false;
+  m_raw = NULL;
+  m_rawlen = 0;
+  memset(&m_hdr, 0, sizeof(m_hdr));
+  m_last.tv_sec = m_last.tv_usec = 0;
+  m_outpos = 0;
+
+  memset(&m_zin, 0, sizeof(m_zin));
+  m_zin_init = false;
+  m_inraw = NULL;
+  m_inrawlen = 0;
+  m_inrawpos = 0;
+  m_inremain = 0;
+  m_inlast.tv_sec = m_inlast.tv_usec = 0;
+  m_putfilter = NULL;
+  m_putstart.tv_sec = m_putstart.tv_usec = 0;
+  m_blockcount = 0;
+  m_skipcount = 0;
+  }
+
+canformat_zlog::~canformat_zlog()
+  {
+  if (m_zout_init) deflateEnd(&m_zout);
+  if (m_zin_init) inflateEnd(&m_zin);
+  if (m_raw) free(m_raw);
+  if (m_inraw) free(m_inraw);
+  }
+
+std::string canformat_zlog::getheader(struct timeval *time)
+  {
+  zlog_file_hdr_t h;
+  struct timeval t;
+
+  if (time == NULL)
+    {
+    gettimeofday(&t,NULL);
+    time = &t;
+    }
+
+  memset(&h,0,sizeof(h));
+  h.magic = CANFORMAT_ZLOG_MAGIC;
+  h.version = CANFORMAT_ZLOG_VERSION;
+  h.ts_sec = time->tv_sec;
+  h.ts_usec = time->tv_usec;
+
+  return std::string((const char*)&h, sizeof(h));
+  }
+
+size_t canformat_zlog::getbuf(CAN_log_message_t* message, uint8_t* buffer, size_t size)
+  {
+  if ((message->type == CAN_LogFrame_RX)||
+      (message->type == CAN_LogFrame_TX))
+    {
+    AddRecord(message);
+    }
+  return ReadOutput(buffer, size);
+  }
+
+size_t canformat_zlog::getflush(uint8_t* buffer, size_t size)
+  {
+  CloseBlock();
+  return ReadOutput(buffer, size);
+  }
+
+/**
+ * ReadOutput: copy finished block data into the output buffer
+ *  Blocks are produced much slower than they are read (one block per few
+ *  hundred messages), so the pending output stays small.
+ */
+size_t canformat_zlog::ReadOutput(uint8_t* buffer, size_t size)
+  {
+  size_t len = MIN(size, m_out.size() - m_outpos);
+  if (len == 0) return 0;
+  memcpy(buffer, m_out.data() + m_outpos, len);
+  m_outpos += len;
+  if (m_outpos == m_out.size())
+    {
+    m_out.clear();
+    m_outpos = 0;
+    }
+  return len;
+  }
+
+void canformat_zlog::AddRecord(CAN_log_message_t* message)
+  {
+  if (m_raw == NULL)
+    {
+    m_raw = (uint8_t*)ExternalRamMalloc(CANFORMAT_ZLOG_RAWSIZE);
+    if (m_raw == NULL) return;
+    }
+
+  const struct timeval &ts = message->timestamp;
+  uint8_t bus = (message->frame.origin != NULL) ? message->frame.origin->m_busnumber + 1 : 0;
+  uint32_t idflags = message->frame.MsgID;
+  if (message->frame.FIR.B.FF == CAN_frame_ext) idflags |= CANFORMAT_ZLOG_ID_EXT;
+  uint64_t key = ((uint64_t)bus << 32) | idflags;
+
+  // Close the block if full or if the time span gets too large.
+  // Small backwards steps (frames from different buses) are allowed,
+  // so the header holds the latest time of the block.
+  if (m_hdr.count > 0)
+    {
+    if ((m_rawlen + CANFORMAT_ZLOG_RECMAXLEN > CANFORMAT_ZLOG_RAWSIZE) ||
+        (m_dict.size() >= CANFORMAT_ZLOG_MAXIDS && m_idmap.find(key) == m_idmap.end()) ||
+        (ts.tv_sec - (time_t)m_hdr.first_sec >= CANFORMAT_ZLOG_MAXAGE) ||
+        ((time_t)m_hdr.last_sec - ts.tv_sec >= CANFORMAT_ZLOG_MAXAGE))
+      {
+      CloseBlock();
+      }
+    }
+  if (m_hdr.count == 0)
+    {
+    m_hdr.first_sec = m_hdr.last_sec = ts.tv_sec;
+    m_hdr.first_usec = m_hdr.last_usec = ts.tv_usec;
+    m_last = ts;
+    }
+
+  // Lookup / add dictionary entry:
+  uint16_t index;
+  auto it = m_idmap.find(key);
+  if (it != m_idmap.end())
+    {
+    index = it->second;
+    }
+  else
+    {
+    index = m_dict.size();
+    m_idmap[key] = index;
+    zlog_dict_entry_t entry;
+    entry.idflags = idflags;
+    entry.bus = bus;
+    m_dict.push_back(entry);
+    }
+
+  // Encode record:
+  struct timeval delta;
+  timersub(&ts, &m_last, &delta);
+  uint8_t dlc = MIN(message->frame.FIR.B.DLC, 8);
+  uint8_t* p = m_raw + m_rawlen;
+  *p++ = dlc
+    | ((message->type == CAN_LogFrame_TX) ? CANFORMAT_ZLOG_REC_TX : 0)
+    | ((message->frame.FIR.B.RTR == CAN_RTR) ? CANFORMAT_ZLOG_REC_RTR : 0);
+  int32_t udelta = delta.tv_sec * 1000000 + delta.tv_usec;
+  p = zlog_put_varint(p, ((uint32_t)udelta << 1) ^ (uint32_t)(udelta >> 31));
+  p = zlog_put_varint(p, index);
+  memcpy(p, message->frame.data.u8, dlc);
+  p += dlc;
+  m_rawlen = p - m_raw;
+
+  m_last = ts;
+  if (ts.tv_sec > (time_t)m_hdr.last_sec ||
+      (ts.tv_sec == (time_t)m_hdr.last_sec && ts.tv_usec > (suseconds_t)m_hdr.last_usec))
+    {
+    m_hdr.last_sec = ts.tv_sec;
+    m_hdr.last_usec = ts.tv_usec;
+    }
+  m_hdr.count++;
+  }
+
+/**
+ * CloseBlock: compress the current block and append it to the output
+ */
+void canformat_zlog::CloseBlock()
+  {
+  if (m_hdr.count == 0) return;
+
+  if (!m_zout_init)
+    {
+    m_zout.zalloc = zlog_zalloc;
+    m_zout.zfree = zlog_zfree;
+    // small window & memory level: ~40 KB state instead of 256 KB
+    if (deflateInit2(&m_zout, 3, Z_DEFLATED, 12, 5, Z_DEFAULT_STRATEGY) != Z_OK)
+      {
+      ESP_LOGE(TAG, "deflateInit2 failed, dropping %u frames", m_hdr.count);
+      goto reset;
+      }
+    m_zout_init = true;
+    }
+  else
+    {
+    deflateReset(&m_zout);
+    }
+
+  {
+  size_t dictlen = m_dict.size() * sizeof(zlog_dict_entry_t);
+  size_t start = m_out.size();
+  size_t datapos = start + sizeof(zlog_block_hdr_t) + dictlen;
+  m_out.resize(datapos + deflateBound(&m_zout, m_rawlen));
+
+  m_zout.next_in = m_raw;
+  m_zout.avail_in = m_rawlen;
+  m_zout.next_out = (Bytef*)&m_out[datapos];
+  m_zout.avail_out = m_out.size() - datapos;
+  if (deflate(&m_zout, Z_FINISH) != Z_STREAM_END)
+    {
+    ESP_LOGE(TAG, "deflate failed, dropping %u frames", m_hdr.count);
+    m_out.resize(start);
+    goto reset;
+    }
+
+  m_hdr.magic = CANFORMAT_ZLOG_BLOCKMAGIC;
+  m_hdr.complen = m_zout.total_out;
+  m_hdr.rawlen = m_rawlen;
+  m_hdr.idcount = m_dict.size();
+  m_hdr.reserved = 0;
+  memcpy(&m_out[start], &m_hdr, sizeof(m_hdr));
+  memcpy(&m_out[start + sizeof(m_hdr)], m_dict.data(), dictlen);
+  m_out.resize(datapos + m_hdr.complen);
+  }
+
+reset:
+  m_rawlen = 0;
+  memset(&m_hdr, 0, sizeof(m_hdr));
+  m_idmap.clear();
+  m_dict.clear();
+  }
+
+/**
+ * putpending: input bytes buffered & records not yet returned
+ */
+size_t canformat_zlog::putpending()
+  {
+  return m_in.size() + m_inremain;
+  }
+
+/**
+ * SetPutFilter: skip blocks & records not matching the filter / before start
+ *  Blocks are skipped based on their index, without inflating them.
+ */
+void canformat_zlog::SetPutFilter(canfilter* filter, const struct timeval* start)
+  {
+  m_putfilter = filter;
+  if (start)
+    m_putstart = *start;
+  else
+    m_putstart.tv_sec = m_putstart.tv_usec = 0;
+  }
+
+/**
+ * InputNeeded: number of bytes missing to complete the current input unit
+ */
+size_t canformat_zlog::InputNeeded()
+  {
+  while (m_in.size() >= sizeof(uint32_t))
+    {
+    uint32_t magic;
+    memcpy(&magic, m_in.data(), sizeof(magic));
+    if (magic == CANFORMAT_ZLOG_MAGIC)
+      {
+      return sizeof(zlog_file_hdr_t) - MIN(m_in.size(), sizeof(zlog_file_hdr_t));
+      }
+    else if (magic == CANFORMAT_ZLOG_BLOCKMAGIC)
+      {
+      if (m_in.size() < sizeof(zlog_block_hdr_t))
+        return sizeof(zlog_block_hdr_t) - m_in.size();
+      zlog_block_hdr_t hdr;
+      memcpy(&hdr, m_in.data(), sizeof(hdr));
+      // Validate the header before buffering the block, the stream may be corrupted:
+      if (hdr.idcount <= CANFORMAT_ZLOG_MAXIDS &&
+          hdr.complen <= CANFORMAT_ZLOG_COMPMAXLEN &&
+          hdr.rawlen <= CANFORMAT_ZLOG_RAWSIZE)
+        {
+        size_t blocklen = sizeof(hdr) + hdr.idcount * sizeof(zlog_dict_entry_t) + hdr.complen;
+        return blocklen - MIN(m_in.size(), blocklen);
+        }
+      ESP_LOGW(TAG, "Invalid block header (idcount=%u complen=%u rawlen=%u), resyncing",
+        hdr.idcount, hdr.complen, hdr.rawlen);
+      }
+    else
+      {
+      return 0; // unknown: resync
+      }
+    m_in.erase(0, 1); // invalid block header: resync
+    }
+
+  return sizeof(uint32_t) - m_in.size();
+  }
+
+bool canformat_zlog::InputSkip(const zlog_block_hdr_t* hdr, const zlog_dict_entry_t* dict)
+  {
+  if (m_putstart.tv_sec)
+    {
+    struct timeval last = { (time_t)hdr->last_sec, (suseconds_t)hdr->last_usec };
+    if (timercmp(&last, &m_putstart, <))
+      return true;
+    }
+
+  if (m_putfilter)
+    {
+    CAN_frame_t frame;
+    memset(&frame, 0, sizeof(frame));
+    for (int i = 0; i < hdr->idcount; i++)
+      {
+      zlog_dict_entry_t entry;
+      memcpy(&entry, &dict[i], sizeof(entry));
+      frame.origin = (entry.bus > 0) ? MyCan.GetBus(entry.bus - 1) : NULL;
+      frame.MsgID = entry.idflags & ~CANFORMAT_ZLOG_ID_EXT;
+      if (m_putfilter->IsFiltered(&frame))
+        return false;
+      }
+    return true;
+    }
+
+  return false;
+  }
+
+/**
+ * InputBlock: process a complete input unit (file header or block)
+ */
+void canformat_zlog::InputBlock()
+  {
+  uint32_t magic;
+  memcpy(&magic, m_in.data(), sizeof(magic));
+  if (magic != CANFORMAT_ZLOG_BLOCKMAGIC)
+    {
+    m_in.clear(); // file header
+    return;
+    }
+
+  zlog_block_hdr_t hdr;
+  memcpy(&hdr, m_in.data(), sizeof(hdr));
+  const zlog_dict_entry_t* dict = (const zlog_dict_entry_t*)(m_in.data() + sizeof(hdr));
+  const uint8_t* data = (const uint8_t*)m_in.data() + sizeof(hdr) + hdr.idcount * sizeof(zlog_dict_entry_t);
+  m_blockcount++;
+
+  if (InputSkip(&hdr, dict))
+    {
+    m_skipcount++;
+    m_in.clear();
+    return;
+    }
+
+  if (hdr.rawlen > CANFORMAT_ZLOG_RAWSIZE)
+    {
+    ESP_LOGW(TAG, "Block too large (%u bytes), skipped", hdr.rawlen);
+    m_in.clear();
+    return;
+    }
+  if (m_inraw == NULL)
+    {
+    m_inraw = (uint8_t*)ExternalRamMalloc(CANFORMAT_ZLOG_RAWSIZE);
+    if (m_inraw == NULL) { m_in.clear(); return; }
+    }
+  if (!m_zin_init)
+    {
+    m_zin.zalloc = zlog_zalloc;
+    m_zin.zfree = zlog_zfree;
+    if (inflateInit2(&m_zin, 12) != Z_OK)
+      {
+      ESP_LOGE(TAG, "inflateInit2 failed");
+      m_in.clear();
+      return;
+      }
+    m_zin_init = true;
+    }
+  else
+    {
+    inflateReset(&m_zin);
+    }
+
+  m_zin.next_in = (Bytef*)data;
+  m_zin.avail_in = hdr.complen;
+  m_zin.next_out = m_inraw;
+  m_zin.avail_out = CANFORMAT_ZLOG_RAWSIZE;
+  if (inflate(&m_zin, Z_FINISH) != Z_STREAM_END || m_zin.total_out != hdr.rawlen)
+    {
+    ESP_LOGW(TAG, "Block corrupted, skipped");
+    m_in.clear();
+    return;
+    }
+
+  m_indict.resize(hdr.idcount);
+  memcpy(m_indict.data(), dict, hdr.idcount * sizeof(zlog_dict_entry_t));
+  m_inrawlen = hdr.rawlen;
+  m_inrawpos = 0;
+  m_inremain = hdr.count;
+  m_inlast.tv_sec = hdr.first_sec;
+  m_inlast.tv_usec = hdr.first_usec;
+  m_in.clear();
+  }
+
+/**
+ * InputRecord: decode the next record of the current block
+ *  Returns false if no record was available.
+ */
+bool canformat_zlog::InputRecord(CAN_log_message_t* message)
+  {
+  const uint8_t* end = m_inraw + m_inrawlen;
+  while (m_inremain > 0)
+    {
+    m_inremain--;
+    const uint8_t* p = m_inraw + m_inrawpos;
+    uint32_t delta, index;
+    if (p >= end) break;
+    uint8_t flags = *p++;
+    uint8_t dlc = MIN(flags & CANFORMAT_ZLOG_REC_DLC, 8);
+    if (!zlog_get_varint(p, end, delta) || !zlog_get_varint(p, end, index) ||
+        index >= m_indict.size() || p + dlc > end)
+      break;
+    m_inrawpos = (p + dlc) - m_inraw;
+
+    int32_t udelta = (int32_t)(delta >> 1) ^ -(int32_t)(delta & 1);
+    if (udelta >= 0)
+      {
+      struct timeval d = { (time_t)(udelta / 1000000), (suseconds_t)(udelta % 1000000) };
+      timeradd(&m_inlast, &d, &m_inlast);
+      }
+    else
+      {
+      struct timeval d = { (time_t)(-udelta / 1000000), (suseconds_t)(-udelta % 1000000) };
+      timersub(&m_inlast, &d, &m_inlast);
+      }
+    if (m_putstart.tv_sec && timercmp(&m_inlast, &m_putstart, <))
+      continue;
+    const zlog_dict_entry_t& entry = m_indict[index];
+    memset(message, 0, sizeof(*message));
+    message->type = (flags & CANFORMAT_ZLOG_REC_TX) ? CAN_LogFrame_TX : CAN_LogFrame_RX;
+    message->timestamp = m_inlast;
+    message->frame.origin = (entry.bus > 0) ? MyCan.GetBus(entry.bus - 1) : NULL;
+    message->frame.MsgID = entry.idflags & ~CANFORMAT_ZLOG_ID_EXT;
+    message->frame.FIR.B.FF = (entry.idflags & CANFORMAT_ZLOG_ID_EXT) ? CAN_frame_ext : CAN_frame_std;
+    message->frame.FIR.B.RTR = (flags & CANFORMAT_ZLOG_REC_RTR) ? CAN_RTR : CAN_no_RTR;
+    message->frame.FIR.B.DLC = dlc;
+    memcpy(message->frame.data.u8, p, dlc);
+
+    if (m_putfilter && !m_putfilter->IsFiltered(&message->frame))
+      {
+      memset(message, 0, sizeof(*message));
+      continue;
+      }
+    return true;
+    }
+
+  m_inremain = 0;
+  return false;
+  }
+
+size_t canformat_zlog::put(CAN_log_message_t* message, uint8_t *buffer, size_t len, void* userdata)
+  {
+  size_t consumed = 0;
+
+  // Collect input until the next block is complete:
+  while (consumed < len)
+    {
+    size_t need = InputNeeded();
+    if (need == 0)
+      {
+      if (m_in.size() >= sizeof(uint32_t) && m_inremain == 0)
+        {
+        uint32_t magic;
+        memcpy(&magic, m_in.data(), sizeof(magic));
+        if (magic == CANFORMAT_ZLOG_MAGIC || magic == CANFORMAT_ZLOG_BLOCKMAGIC)
+          InputBlock();
+        else
+          m_in.erase(0, 1); // resync
+        continue;
+        }
+      break; // block complete, records still pending
+      }
+    size_t take = MIN(need, len - consumed);
+    m_in.append((const char*)buffer + consumed, take);
+    consumed += take;
+    }
+
+  // Process a completed block if the previous one has been read:
+  if (m_inremain == 0 && m_in.size() >= sizeof(uint32_t) && InputNeeded() == 0)
+    {
+    uint32_t magic;
+    memcpy(&magic, m_in.data(), sizeof(magic));
+    if (magic == CANFORMAT_ZLOG_MAGIC || magic == CANFORMAT_ZLOG_BLOCKMAGIC)
+      InputBlock();
+    }
+
+  InputRecord(message);
+  return consumed;
+  }
+
+#endif // #ifdef CONFIG_OVMS_SC_ZIP
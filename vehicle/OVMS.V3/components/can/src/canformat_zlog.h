@@ -0,0 +1,160 @@
+/*
+;    Project:       Open Vehicle Monitor System
+;    Module:        CAN dump compressed binary block format
+;    Date:          16th October 2026
+;
+;    (C) 2026       Open Vehicles
+;
+; Permission is hereby granted, free of charge, to any person obtaining a copy
+; of this software and associated documentation files (the "Software"), to deal
+; in the Software without restriction, including without limitation the rights
+; to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+; copies of the Software, and to permit persons to whom the Software is
+; furnished to do so, subject to the following conditions:
+;
+; The above copyright notice and this permission notice shall be included in
+; all copies or substantial portions of the Software.
+;
+; THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+; IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+; FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+; AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+; LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+; OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+; THE SOFTWARE.
+*/
+
+#ifndef __CANFORMAT_ZLOG_H__
+#define __CANFORMAT_ZLOG_H__
+
+#include "canformat.h"
+
+#ifdef CONFIG_OVMS_SC_ZIP
+
+#include <map>
+#include <vector>
+#include "zlib.h"
+
+/**
+ * zlog: compressed binary CAN frame log
+ *
+ * The stream consists of an optional file header followed by blocks.
+ * Each block starts with an index (time range & dictionary of the bus/IDs
+ * contained), followed by the deflate compressed records. Readers can skip
+ * blocks by time or ID set without inflating them.
+ *
+ * Record encoding (uncompressed):
+ *   uint8   flags: DLC (bits 0-3), TX (bit 4), RTR (bit 5)
+ *   varint  signed (zigzag) microseconds since previous record
+ *           (first record: since block start time)
+ *   varint  dictionary index
+ *   uint8[] data (DLC bytes)
+ *
+ * All values are little endian. Only frame messages (RX/TX) are logged.
+ */
+
+#define CANFORMAT_ZLOG_MAGIC        0x4c5a564f  // "OVZL" file header
+#define CANFORMAT_ZLOG_BLOCKMAGIC   0x425a564f  // "OVZB" block header
+#define CANFORMAT_ZLOG_VERSION      1
+#define CANFORMAT_ZLOG_RAWSIZE      8192        // Uncompressed block size
+#define CANFORMAT_ZLOG_MAXIDS       512         // Max dictionary entries per block
+#define CANFORMAT_ZLOG_MAXAGE       10          // Max block time span [s]
+#define CANFORMAT_ZLOG_RECMAXLEN    (1+5+3+8)   // Max record size
+#define CANFORMAT_ZLOG_COMPMAXLEN   (CANFORMAT_ZLOG_RAWSIZE + ((CANFORMAT_ZLOG_RAWSIZE+7)>>3) \
+                                    + ((CANFORMAT_ZLOG_RAWSIZE+63)>>6) + 5 + 6)
+                                                // Max compressed block size (deflateBound)
+
+#define CANFORMAT_ZLOG_REC_DLC      0x0f
+#define CANFORMAT_ZLOG_REC_TX       0x10
+#define CANFORMAT_ZLOG_REC_RTR      0x20
+
+#define CANFORMAT_ZLOG_ID_EXT       0x80000000  // Dictionary: extended frame flag
+
+typedef struct __attribute__ ((__packed__))
+  {
+  uint32_t magic;         /* CANFORMAT_ZLOG_MAGIC */
+  uint8_t version;        /* format version */
+  uint8_t reserved[3];
+  uint32_t ts_sec;        /* log start time */
+  uint32_t ts_usec;
+  } zlog_file_hdr_t;
+
+typedef struct __attribute__ ((__packed__))
+  {
+  uint32_t magic;         /* CANFORMAT_ZLOG_BLOCKMAGIC */
+  uint32_t complen;       /* compressed data length */
+  uint32_t rawlen;        /* uncompressed data length */
+  uint32_t count;         /* number of records */
+  uint32_t first_sec;     /* time of first record */
+  uint32_t first_usec;
+  uint32_t last_sec;      /* latest record time */
+  uint32_t last_usec;
+  uint16_t idcount;       /* number of dictionary entries following */
+  uint16_t reserved;
+  } zlog_block_hdr_t;
+
+typedef struct __attribute__ ((__packed__))
+  {
+  uint32_t idflags;       /* CAN ID, CANFORMAT_ZLOG_ID_EXT = extended frame */
+  uint8_t bus;            /* 0 = unknown, else bus number + 1 */
+  } zlog_dict_entry_t;
+
+class canformat_zlog : public canformat
+  {
+  public:
+    canformat_zlog(const char* type);
+    virtual ~canformat_zlog();
+
+  public:
+    virtual size_t getbuf(CAN_log_message_t* message, uint8_t* buffer, size_t size);
+    virtual size_t getflush(uint8_t* buffer, size_t size);
+    virtual std::string getheader(struct timeval *time);
+    virtual size_t put(CAN_log_message_t* message, uint8_t *buffer, size_t len, void* userdata=NULL);
+    virtual size_t putpending();
+    virtual void SetPutFilter(canfilter* filter, const struct timeval* start=NULL);
+
+  protected:
+    void AddRecord(CAN_log_message_t* message);
+    void CloseBlock();
+    size_t ReadOutput(uint8_t* buffer, size_t size);
+
+  protected:
+    size_t InputNeeded();
+    void InputBlock();
+    bool InputSkip(const zlog_block_hdr_t* hdr, const zlog_dict_entry_t* dict);
+    bool InputRecord(CAN_log_message_t* message);
+
+  protected:
+    // Writer:
+    z_stream m_zout;
+    bool m_zout_init;
+    uint8_t* m_raw;
+    size_t m_rawlen;
+    zlog_block_hdr_t m_hdr;
+    struct timeval m_last;
+    std::map<uint64_t, uint16_t> m_idmap;
+    std::vector<zlog_dict_entry_t> m_dict;
+    std::string m_out;                  // finished blocks waiting for output
+    size_t m_outpos;
+
+    // Reader:
+    z_stream m_zin;
+    bool m_zin_init;
+    std::string m_in;                   // block being received
+    uint8_t* m_inraw;
+    size_t m_inrawlen;
+    size_t m_inrawpos;
+    uint32_t m_inremain;
+    struct timeval m_inlast;
+    std::vector<zlog_dict_entry_t> m_indict;
+    canfilter* m_putfilter;
+    struct timeval m_putstart;
+
+  public:
+    uint32_t m_blockcount;              // blocks read
+    uint32_t m_skipcount;               // blocks skipped by index
+  };
+
+#endif // #ifdef CONFIG_OVMS_SC_ZIP
+
+#endif // __CANFORMAT_ZLOG_H__
@@ -167,10 +167,15 @@ canlog::canlog(const char* type, std::string format, canformat::canformat_serve_
   m_msgcount = 0;
   m_dropcount = 0;
   m_filtercount = 0;
+  m_flushinterval = 0;
 
   using std::placeholders::_1;
   using std::placeholders::_2;
-  MyEvents.RegisterEvent(IDTAG, "*", std::bind(&canlog::EventListener, this, _1, _2));
+  using std::placeholders::_3;
+  MyEvents.RegisterEventId(IDTAG, "*", std::bind(&canlog::EventListener, this, _1, _2, _3));
+
+  m_outsize = CANLOG_BATCH_SIZE * CANFORMAT_MAXLEN;
+  m_outbuf = (uint8_t*)ExternalRamMalloc(m_outsize);
 
   int queuesize = MyConfig.GetParamValueInt("can", "log.queuesize",100);
   m_queue = xQueueCreate(queuesize, sizeof(CAN_log_message_t));
@@ -222,36 +227,71 @@ canlog::~canlog()
     delete m_filter;
     m_filter = NULL;
     }
+
+  if (m_outbuf)
+    {
+    free(m_outbuf);
+    m_outbuf = NULL;
+    }
   }
 
 void canlog::RxTask(void *context)
   {
   canlog* me = (canlog*) context;
-  CAN_log_message_t msg;
+  CAN_log_message_t msgs[CANLOG_BATCH_SIZE];
+  bool flushpending = false;
+  TickType_t lastflush = xTaskGetTickCount();
   while (1)
     {
-    if (xQueueReceive(me->m_queue, &msg, (portTickType)portMAX_DELAY) == pdTRUE)
+    if (xQueueReceive(me->m_queue, &msgs[0], pdMS_TO_TICKS(CANLOG_FLUSH_IDLE)) != pdTRUE)
       {
-      switch (msg.type)
+      // queue idle: output data buffered by the format
+      if (flushpending)
         {
-        case CAN_LogInfo_Comment:
-        case CAN_LogInfo_Config:
-        case CAN_LogInfo_Event:
-          me->OutputMsg(msg);
-          free(msg.text);
-          break;
-        default:
-          me->OutputMsg(msg);
-          break;
+        me->OutputFlush();
+        flushpending = false;
+        lastflush = xTaskGetTickCount();
+        }
+      }
+    else
+      {
+      // fetch all messages waiting, up to the batch size:
+      int count = 1;
+      while (count < CANLOG_BATCH_SIZE && xQueueReceive(me->m_queue, &msgs[count], 0) == pdTRUE)
+        count++;
+
+      me->OutputMsgs(msgs, count);
+
+      for (int i = 0; i < count; i++)
+        {
+        switch (msgs[i].type)
+          {
+          case CAN_LogInfo_Comment:
+          case CAN_LogInfo_Config:
+          case CAN_LogInfo_Event:
+            free(msgs[i].text);
+            break;
+          default:
+            break;
+          }
+        }
+
+      flushpending = true;
+      if (me->m_flushinterval &&
+          xTaskGetTickCount() - lastflush >= pdMS_TO_TICKS(me->m_flushinterval))
+        {
+        me->OutputFlush();
+        flushpending = false;
+        lastflush = xTaskGetTickCount();
         }
       }
     }
   }
 
-void canlog::EventListener(std::string event, void* data)
+void canlog::EventListener(event_id_t id, const char* event, void* data)
   {
-  if (startsWith(event, "vehicle"))
-    LogInfo(NULL, CAN_LogInfo_Event, event.c_str());
+  if (strncmp(event, "vehicle", 7) == 0)
+    LogInfo(NULL, CAN_LogInfo_Event, event);
   }
 
 const char* canlog::GetType()
@@ -268,6 +308,42 @@ void canlog::OutputMsg(CAN_log_message_t& msg)
   {
   }
 
+/**
+ * OutputMsgs: output a batch of messages
+ *  Default implementation: pass each message to OutputMsg().
+ *  Loggers writing to a file or stream should override this and use
+ *  FormatMsgs() to write the batch with a single call.
+ */
+void canlog::OutputMsgs(CAN_log_message_t* msgs, int count)
+  {
+  for (int i = 0; i < count; i++)
+    OutputMsg(msgs[i]);
+  }
+
+/**
+ * OutputFlush: output data buffered by the format
+ *  Default implementation: nothing to do. Loggers supporting buffering formats
+ *  should override this and write the getflush() results.
+ */
+void canlog::OutputFlush()
+  {
+  }
+
+/**
+ * FormatMsgs: format messages into m_outbuf
+ *  Returns the length of the output, done is set to the number of messages
+ *  consumed (call again with the rest if done < count).
+ */
+size_t canlog::FormatMsgs(CAN_log_message_t* msgs, int count, int* done)
+  {
+  if (m_formatter == NULL || m_outbuf == NULL)
+    {
+    *done = count;
+    return 0;
+    }
+  return m_formatter->getbatch(msgs, count, m_outbuf, m_outsize, done);
+  }
+
 std::string canlog::GetInfo()
   {
   std::ostringstream buf;
@@ -31,6 +31,10 @@
 #include "can.h"
 #include "canformat.h"
 
+#define CANLOG_BATCH_SIZE   8       // Max messages fetched from the queue per output call
+#define CANLOG_FLUSH_IDLE   1000    // Idle time [ms] after which buffered format output is flushed
+#define CANLOG_FLUSH_STREAM 1000    // Max output latency [ms] for streaming loggers
+
 /**
  * canlog is the general interface and base implementation for all can loggers.
  *  It provides standard methods to open files and configure message filters
@@ -42,7 +46,13 @@
  *
  * Log messages are sent to a canlog through a queue handled by a separate
  *  task for the logger, so logging doesn't affect CAN framework speed and
- *  a log can be written/streamed to a slow medium.
+ *  a log can be written/streamed to a slow medium. The task fetches up to
+ *  CANLOG_BATCH_SIZE messages at once and passes them to OutputMsgs(), so
+ *  loggers can format them into m_outbuf and write them in one go.
+ *
+ * Formats may buffer output (i.e. zlog blocks). The task calls OutputFlush()
+ *  when the queue has been idle for CANLOG_FLUSH_IDLE ms, and additionally
+ *  every m_flushinterval ms if set (used by streaming loggers).
  *
  * Log entries can be frames, status or info messages (see CAN_LogEntry_t).
  * The timestamp of the original event is preserved.
@@ -59,7 +69,7 @@ class canlog : public InternalRamAllocated
 
   public:
     static void RxTask(void* context);
-    void EventListener(std::string event, void* data);
+    void EventListener(event_id_t id, const char* event, void* data);
 
   public:
     const char* GetType();
@@ -73,6 +83,11 @@ class canlog : public InternalRamAllocated
     virtual bool IsOpen() = 0;
     virtual std::string GetInfo();
     virtual void OutputMsg(CAN_log_message_t& msg);
+    virtual void OutputMsgs(CAN_log_message_t* msgs, int count);
+    virtual void OutputFlush();
+
+  protected:
+    size_t FormatMsgs(CAN_log_message_t* msgs, int count, int* done);
 
   public:
     virtual void SetFilter(canfilter* filter);
@@ -93,9 +108,12 @@ class canlog : public InternalRamAllocated
   public:
     TaskHandle_t        m_task;
     QueueHandle_t       m_queue;
+    uint8_t*            m_outbuf;
+    size_t              m_outsize;
     uint32_t            m_msgcount;
     uint32_t            m_dropcount;
     uint32_t            m_filtercount;
+    uint32_t            m_flushinterval;  // Max time [ms] between OutputFlush() calls while busy, 0 = idle only
   };
 
 #endif // __CANLOG_H__
@@ -138,6 +138,7 @@ canlog_tcpclient::canlog_tcpclient(std::string path, std::string format, canform
   m_mgconn = NULL;
   m_isopen = false;
   m_path = path;
+  m_flushinterval = CANLOG_FLUSH_STREAM;
   }
 
 canlog_tcpclient::~canlog_tcpclient()
@@ -209,24 +210,49 @@ std::string canlog_tcpclient::GetInfo()
   }
 
 void canlog_tcpclient::OutputMsg(CAN_log_message_t& msg)
+  {
+  OutputMsgs(&msg, 1);
+  }
+
+void canlog_tcpclient::OutputMsgs(CAN_log_message_t* msgs, int count)
   {
   if (m_formatter == NULL) return;
 
-  if ((m_mgconn != NULL)&&(m_isopen))
+  int done;
+  while ((m_mgconn != NULL)&&(m_isopen)&&(count > 0))
     {
-    std::string result = m_formatter->get(&msg);
-    if (result.length()>0)
+    size_t len = FormatMsgs(msgs, count, &done);
+    if (len > 0)
       {
       OvmsMutexLock lock(&m_mgmutex);
+      if (m_mgconn == NULL)
+        break;
       if (m_mgconn->send_mbuf.len < 4096)
         {
-        mg_send(m_mgconn, (const char*)result.c_str(), result.length());
+        mg_send(m_mgconn, (const char*)m_outbuf, len);
         }
       else
         {
-        m_dropcount++;
+        m_dropcount += done;
         }
       }
+    msgs += done;
+    count -= done;
+    }
+  }
+
+void canlog_tcpclient::OutputFlush()
+  {
+  if (m_formatter == NULL || m_outbuf == NULL) return;
+
+  size_t len;
+  while ((len = m_formatter->getflush(m_outbuf, m_outsize)) > 0)
+    {
+    OvmsMutexLock lock(&m_mgmutex);
+    if ((m_mgconn != NULL)&&(m_isopen)&&(m_mgconn->send_mbuf.len < 4096))
+      {
+      mg_send(m_mgconn, (const char*)m_outbuf, len);
+      }
     }
   }
 
@@ -154,6 +154,7 @@ canlog_tcpserver::canlog_tcpserver(std::string path, std::string format, canform
     }
   m_isopen = false;
   m_mgconn = NULL;
+  m_flushinterval = CANLOG_FLUSH_STREAM;
 
   if (m_formatter)
     {
@@ -235,24 +236,51 @@ std::string canlog_tcpserver::GetInfo()
   }
 
 void canlog_tcpserver::OutputMsg(CAN_log_message_t& msg)
+  {
+  OutputMsgs(&msg, 1);
+  }
+
+void canlog_tcpserver::OutputMsgs(CAN_log_message_t* msgs, int count)
   {
   if (m_formatter == NULL) return;
 
-  std::string result = m_formatter->get(&msg);
-  if (result.length()>0)
+  int done;
+  while (count > 0)
+    {
+    size_t len = FormatMsgs(msgs, count, &done);
+    if (len > 0)
+      {
+      OvmsMutexLock lock(&m_mgmutex);
+      for (ts_map_t::iterator it=m_smap.begin(); it!=m_smap.end(); ++it)
+        {
+        if (it->first->send_mbuf.len < 4096)
+          {
+          // Limit to 4KB queue on output buffer
+          mg_send(it->first, (const char*)m_outbuf, len);
+          }
+        else
+          {
+          m_dropcount += done;
+          }
+        }
+      }
+    msgs += done;
+    count -= done;
+    }
+  }
+
+void canlog_tcpserver::OutputFlush()
+  {
+  if (m_formatter == NULL || m_outbuf == NULL) return;
+
+  size_t len;
+  while ((len = m_formatter->getflush(m_outbuf, m_outsize)) > 0)
     {
     OvmsMutexLock lock(&m_mgmutex);
     for (ts_map_t::iterator it=m_smap.begin(); it!=m_smap.end(); ++it)
       {
       if (it->first->send_mbuf.len < 4096)
-        {
-        // Limit to 4KB queue on output buffer
-        mg_send(it->first, (const char*)result.c_str(), result.length());
-        }
-      else
-        {
-        m_dropcount++;
-        }
+        mg_send(it->first, (const char*)m_outbuf, len);
       }
     }
   }
@@ -50,6 +50,8 @@ class canlog_tcpserver : public canlog
 
   public:
     virtual void OutputMsg(CAN_log_message_t& msg);
+    virtual void OutputMsgs(CAN_log_message_t* msgs, int count);
+    virtual void OutputFlush();
 
   public:
     void MongooseHandler(struct mg_connection *nc, int ev, void *p);
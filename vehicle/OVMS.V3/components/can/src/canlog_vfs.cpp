@@ -30,6 +30,7 @@ static const char *TAG = "canlog-vfs";
 #include "can.h"
 #include "canformat.h"
 #include "canlog_vfs.h"
+#include <unistd.h>
 #include "ovms_utils.h"
 #include "ovms_config.h"
 #include "ovms_peripherals.h"
@@ -148,8 +149,16 @@ bool canlog_vfs::Open()
 
 void canlog_vfs::Close()
   {
+  OvmsMutexLock lock(&m_filemutex);
   if (m_file)
     {
+    // write data buffered by the formatter:
+    if (m_formatter && m_outbuf)
+      {
+      size_t len;
+      while ((len = m_formatter->getflush(m_outbuf, m_outsize)) > 0)
+        fwrite(m_outbuf,len,1,m_file);
+      }
     fclose(m_file);
     m_file = NULL;
     ESP_LOGI(TAG, "Closed vfs log '%s': %s",
@@ -180,10 +189,42 @@ void canlog_vfs::MountListener(std::string event, void* data)
 
 void canlog_vfs::OutputMsg(CAN_log_message_t& msg)
   {
+  OutputMsgs(&msg, 1);
+  }
+
+void canlog_vfs::OutputMsgs(CAN_log_message_t* msgs, int count)
+  {
+  OvmsMutexLock lock(&m_filemutex);
   if (m_file == NULL) return;
   if (m_formatter == NULL) return;
 
-  std::string result = m_formatter->get(&msg);
-  if (result.length()>0)
-    fwrite(result.c_str(),result.length(),1,m_file);
+  int done;
+  while (count > 0)
+    {
+    size_t len = FormatMsgs(msgs, count, &done);
+    if (len > 0)
+      fwrite(m_outbuf,len,1,m_file);
+    msgs += done;
+    count -= done;
+    }
+  }
+
+void canlog_vfs::OutputFlush()
+  {
+  OvmsMutexLock lock(&m_filemutex);
+  if (m_file == NULL) return;
+  if (m_formatter == NULL || m_outbuf == NULL) return;
+
+  size_t len, total = 0;
+  while ((len = m_formatter->getflush(m_outbuf, m_outsize)) > 0)
+    {
+    fwrite(m_outbuf,len,1,m_file);
+    total += len;
+    }
+  if (total > 0)
+    {
+    // logging paused: make sure the data survives a power loss
+    fflush(m_file);
+    fsync(fileno(m_file));
+    }
   }
@@ -29,6 +29,7 @@
 #define __CANLOG_VFS_H__
 
 #include "canlog.h"
+#include "ovms_mutex.h"
 
 class canlog_vfs : public canlog
   {
@@ -44,6 +45,8 @@ class canlog_vfs : public canlog
 
   public:
     virtual void OutputMsg(CAN_log_message_t& msg);
+    virtual void OutputMsgs(CAN_log_message_t* msgs, int count);
+    virtual void OutputFlush();
 
   public:
     virtual void MountListener(std::string event, void* data);
@@ -51,6 +54,7 @@ class canlog_vfs : public canlog
   public:
     std::string         m_path;
     FILE*               m_file;
+    OvmsMutex           m_filemutex;
   };
 
 #endif // __CANLOG_VFS_H__
@@ -200,6 +200,7 @@ canplay::canplay(const char* type, std::string format, canformat::canformat_serv
   m_formatter->SetServeMode(mode);
   m_filter = NULL;
   m_speed = 1;
+  m_start.tv_sec = m_start.tv_usec = 0;
 
   m_msgcount = 0;
   xTaskCreatePinnedToCore(PlayTask, "OVMS CanPlay", 4096, (void*)this, 10, &m_task, CORE(1));
@@ -275,6 +276,13 @@ std::string canplay::GetInfo()
 
   buf << " Speed:" << m_speed << "x";
 
+  if (m_start.tv_sec)
+    {
+    buf << " Start:" << m_start.tv_sec;
+    if (m_start.tv_usec)
+      buf << "." << std::setfill('0') << std::setw(6) << m_start.tv_usec;
+    }
+
   if (m_filter)
     {
     buf << " Filter:" << m_filter->Info();
@@ -298,6 +306,10 @@ std::string canplay::GetStats()
 
 void canplay::SetFilter(canfilter* filter)
   {
+  if (m_formatter)
+    {
+    m_formatter->SetPutFilter(filter, &m_start);
+    }
   if (m_filter)
     {
     delete m_filter;
@@ -307,9 +319,52 @@ void canplay::SetFilter(canfilter* filter)
 
 void canplay::ClearFilter()
   {
+  if (m_formatter)
+    {
+    m_formatter->SetPutFilter(NULL, &m_start);
+    }
   if (m_filter)
     {
     delete m_filter;
     m_filter = NULL;
     }
   }
+
+/**
+ * SetStart: skip messages before the start time
+ *  Formats with a block index (zlog) skip whole blocks without decoding them.
+ */
+void canplay::SetStart(const struct timeval* start)
+  {
+  if (start)
+    m_start = *start;
+  else
+    m_start.tv_sec = m_start.tv_usec = 0;
+  if (m_formatter)
+    {
+    m_formatter->SetPutFilter(m_filter, &m_start);
+    }
+  }
+
+/**
+ * IsFiltered: check if a message read is to be played
+ *  Formats may skip messages early (see canformat::SetPutFilter()), but need not.
+ */
+bool canplay::IsFiltered(const CAN_log_message_t* msg)
+  {
+  if (m_start.tv_sec && timercmp(&msg->timestamp, &m_start, <))
+    return false;
+  switch (msg->type)
+    {
+    case CAN_LogFrame_RX:
+    case CAN_LogFrame_TX:
+    case CAN_LogFrame_TX_Queue:
+    case CAN_LogFrame_TX_Fail:
+      if (m_filter && !m_filter->IsFiltered(&msg->frame))
+        return false;
+      break;
+    default:
+      break;
+    }
+  return true;
+  }
@@ -60,6 +60,8 @@ class canplay : public InternalRamAllocated
   public:
     virtual void SetFilter(canfilter* filter);
     virtual void ClearFilter();
+    virtual void SetStart(const struct timeval* start);
+    bool IsFiltered(const CAN_log_message_t* msg);
 
   public:
     const char*         m_type;
@@ -67,6 +69,7 @@ class canplay : public InternalRamAllocated
     uint32_t            m_speed;
     canformat*          m_formatter;
     canfilter*          m_filter;
+    struct timeval      m_start;        // skip messages before this time, 0 = play all
 
   public:
     TaskHandle_t        m_task;
@@ -27,6 +27,7 @@
 #include "ovms_log.h"
 static const char *TAG = "canplay-vfs";
 
+#include <vector>
 #include "can.h"
 #include "canformat.h"
 #include "canplay_vfs.h"
@@ -37,13 +38,35 @@ static const char *TAG = "canplay-vfs";
 void can_play_vfs_start(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv)
   {
   std::string format(cmd->GetName());
-  canplay_vfs* player = new canplay_vfs(argv[0],format);
+
+  // parse args: [-s<start>] <path> [filter1] ... [filterN]
+  struct timeval start = { 0, 0 };
+  std::vector<const char*> args;
+  for (int i=0; i<argc; i++)
+    {
+    if (argv[i][0]=='-' && argv[i][1]=='s')
+      {
+      double t = atof(argv[i]+2);
+      start.tv_sec = (time_t) t;
+      start.tv_usec = (suseconds_t) ((t - start.tv_sec) * 1000000);
+      }
+    else
+      args.push_back(argv[i]);
+    }
+  if (args.empty())
+    {
+    writer->puts("Error: no path given");
+    return;
+    }
+
+  canplay_vfs* player = new canplay_vfs(args[0],format);
   player->Open();
 
   if (player->IsOpen())
     {
-    if (argc>1)
-      { MyCan.AddPlayer(player, argc-1, &argv[1]); }
+    player->SetStart(&start);
+    if (args.size()>1)
+      { MyCan.AddPlayer(player, args.size()-1, &args[1]); }
     else
       { MyCan.AddPlayer(player); }
     writer->printf("CAN playing from VFS active: %s\n", player->GetInfo().c_str());
@@ -77,10 +100,11 @@ OvmsCanPlayVFSInit::OvmsCanPlayVFSInit()
         OvmsCommand* start = cmd_can_play_start->RegisterCommand("vfs", "CAN playing from VFS");
         MyCanFormatFactory.RegisterCommandSet(start, "Start CAN playing from VFS",
           can_play_vfs_start,
-          "<path> [filter1] ... [filterN]\n"
+          "[-s<start>] <path> [filter1] ... [filterN]\n"
+          "Start: skip messages before this time (seconds since epoch)\n"
           "Filter: <bus> | <id>[-<id>] | <bus>:<id>[-<id>]\n"
-          "Example: 2:2a0-37f",
-          1, 9);
+          "Example: -s1600000000 /sd/can.zlog 2:2a0-37f",
+          1, 10);
         }
       }
     }
@@ -91,6 +115,8 @@ canplay_vfs::canplay_vfs(std::string path, std::string format)
   {
   m_file = NULL;
   m_path = path;
+  m_readlen = 0;
+  m_readpos = 0;
   using std::placeholders::_1;
   using std::placeholders::_2;
   MyEvents.RegisterEvent(IDTAG, "sd.mounted", std::bind(&canplay_vfs::MountListener, this, _1, _2));
@@ -129,6 +155,8 @@ bool canplay_vfs::Open()
     }
 #endif // #ifdef CONFIG_OVMS_COMP_SDCARD
 
+  m_readlen = 0;
+  m_readpos = 0;
   m_file = fopen(m_path.c_str(), "r");
   if (!m_file)
     {
@@ -173,10 +201,40 @@ void canplay_vfs::MountListener(std::string event, void* data)
     Open();
   }
 
+/**
+ * InputMsg: read the next message from the file
+ *  Returns false at the end of the file.
+ */
 bool canplay_vfs::InputMsg(CAN_log_message_t* msg)
   {
   if (m_file == NULL) return false;
   if (m_formatter == NULL) return false;
 
-  return false;
+  while (1)
+    {
+    size_t pending = m_formatter->putpending();
+    memset(msg, 0, sizeof(*msg));
+    size_t used = m_formatter->put(msg, m_readbuf + m_readpos, m_readlen - m_readpos);
+    m_readpos += used;
+    if (msg->type != CAN_LogNone)
+      {
+      if (!IsFiltered(msg))
+        continue;
+      m_msgcount++;
+      return true;
+      }
+    if (used > 0 || m_formatter->putpending() != pending)
+      continue; // input buffered or skipped (i.e. a comment line)
+
+    // Format needs more input: keep the unprocessed rest, read on:
+    size_t rest = m_readlen - m_readpos;
+    if (rest == sizeof(m_readbuf))
+      return false; // format cannot process the input
+    memmove(m_readbuf, m_readbuf + m_readpos, rest);
+    m_readpos = 0;
+    size_t len = fread(m_readbuf + rest, 1, sizeof(m_readbuf) - rest, m_file);
+    m_readlen = rest + len;
+    if (len == 0)
+      return false; // end of file
+    }
   }
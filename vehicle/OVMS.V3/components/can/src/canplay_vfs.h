@@ -30,6 +30,8 @@
 
 #include "canplay.h"
 
+#define CANPLAY_VFS_READSIZE 512
+
 class canplay_vfs : public canplay
   {
   public:
@@ -51,6 +53,9 @@ class canplay_vfs : public canplay
   public:
     std::string         m_path;
     FILE*               m_file;
+    uint8_t             m_readbuf[CANPLAY_VFS_READSIZE];
+    size_t              m_readlen;
+    size_t              m_readpos;
   };
 
 #endif // __CANPLAY_VFS_H__
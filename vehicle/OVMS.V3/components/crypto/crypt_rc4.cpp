@@ -89,3 +89,27 @@ void RC4_crypt(RC4_CTX1 *ctx1, RC4_CTX2 *ctx2, uint8_t *msg, int length)
   ctx1->y = y;
   }
 
+/**
+ * Discard keystream bytes, e.g. to skip the weak initial keystream
+ * (same as encrypting 'length' dummy bytes).
+ */
+void RC4_skip(RC4_CTX1 *ctx1, RC4_CTX2 *ctx2, int length)
+  {
+  int i;
+  uint8_t *m, x, y, a;
+
+  x = ctx1->x;
+  y = ctx1->y;
+  m = ctx2->m;
+
+  for (i = 0; i < length; i++)
+    {
+    a = m[++x];
+    y += a;
+    m[x] = m[y];
+    m[y] = a;
+    }
+
+  ctx1->x = x;
+  ctx1->y = y;
+  }
@@ -49,6 +49,7 @@ typedef struct
 
 void RC4_setup(RC4_CTX1 *ctx1, RC4_CTX2 *ctx2, const uint8_t *key, int length);
 void RC4_crypt(RC4_CTX1 *ctx1, RC4_CTX2 *ctx2, uint8_t *msg, int length);
+void RC4_skip(RC4_CTX1 *ctx1, RC4_CTX2 *ctx2, int length);
 
 #endif //#ifndef __CRYPT_RC4_H
 
@@ -580,15 +580,21 @@ dbcSignal::dbcSignal()
   {
   m_start_bit = 0;
   m_signal_size = 0;
+  m_byte_order = DBC_BYTEORDER_LITTLE_ENDIAN;
+  m_value_type = DBC_VALUETYPE_UNSIGNED;
   m_metric = NULL;
+  PrepareDecoder();
   }
 
 dbcSignal::dbcSignal(std::string name)
   {
   m_start_bit = 0;
   m_signal_size = 0;
+  m_byte_order = DBC_BYTEORDER_LITTLE_ENDIAN;
+  m_value_type = DBC_VALUETYPE_UNSIGNED;
   m_name = name;
   m_metric = MyMetrics.Find(name.c_str());
+  PrepareDecoder();
   }
 
 dbcSignal::~dbcSignal()
@@ -762,28 +768,33 @@ void dbcSignal::SetStartSize(const int startbit, const int size)
   {
   m_start_bit = startbit;
   m_signal_size = size;
+  PrepareDecoder();
   }
 
 void dbcSignal::SetByteOrder(const dbcByteOrder_t order)
   {
   m_byte_order = order;
+  PrepareDecoder();
   }
 
 void dbcSignal::SetValueType(const dbcValueType_t type)
   {
   m_value_type = type;
+  PrepareDecoder();
   }
 
 void dbcSignal::SetFactorOffset(const dbcNumber factor, const dbcNumber offset)
   {
   m_factor = factor;
   m_offset = offset;
+  PrepareDecoder();
   }
 
 void dbcSignal::SetFactorOffset(const double factor, const double offset)
   {
   m_factor = factor;
   m_offset = offset;
+  PrepareDecoder();
   }
 
 void dbcSignal::SetMinMax(const dbcNumber minimum, const dbcNumber maximum)
@@ -818,32 +829,84 @@ void dbcSignal::Encode(dbcNumber* source, CAN_frame_t* msg)
   // TODO: An efficient encoding of the signal
   }
 
-dbcNumber dbcSignal::Decode(CAN_frame_t* msg)
+/**
+ * PrepareDecoder: precompute the signal extraction & scaling
+ *
+ * Intel (little endian) signals are extracted from the payload read as a
+ * 64 bit little endian value, Motorola (big endian) signals from the byte
+ * swapped payload, both by a single shift & mask. Signals exceeding the
+ * 8 byte payload fall back to the bitwise extraction.
+ */
+void dbcSignal::PrepareDecoder()
   {
-  uint64_t val;
-  dbcNumber result;
+  int size = m_signal_size;
+  int lsb;
 
   if (m_byte_order == DBC_BYTEORDER_BIG_ENDIAN)
-    val = dbc_extract_bits_big_endian(msg->data.u8,m_start_bit,m_signal_size);
+    {
+    // Start bit is the MSB in sawtooth numbering, map to swapped payload:
+    int msb = (7 - m_start_bit/8) * 8 + (m_start_bit % 8);
+    lsb = msb - (size - 1);
+    }
   else
-    val = dbc_extract_bits_little_endian(msg->data.u8,m_start_bit,m_signal_size);
+    {
+    lsb = m_start_bit;
+    }
 
-  if (m_value_type == DBC_VALUETYPE_UNSIGNED)
-    result.Cast((uint32_t)val, DBC_NUMBER_INTEGER_UNSIGNED);
-  else
-    result.Cast((uint32_t)val, DBC_NUMBER_INTEGER_SIGNED);
+  m_dec_direct = (size > 0 && size <= 64 && lsb >= 0 && lsb + size <= 64);
+  m_dec_shift = m_dec_direct ? lsb : 0;
+  m_dec_mask = (size >= 64) ? UINT64_MAX : (((uint64_t)1 << MAX(size,0)) - 1);
+  m_dec_signed = (m_value_type == DBC_VALUETYPE_SIGNED && size > 0 && size < 64);
+
+  // Scaling: integral factor & offset given as integers keep integer results
+  m_dec_factor = m_factor.IsDefined() ? m_factor.GetDouble() : 1;
+  m_dec_offset = m_offset.IsDefined() ? m_offset.GetDouble() : 0;
+  m_dec_integer = (!m_factor.IsDouble() && !m_offset.IsDouble());
+  m_dec_ifactor = (int64_t)m_dec_factor;
+  m_dec_ioffset = (int64_t)m_dec_offset;
+  }
 
-  // Apply factor and offset
-  if (!(m_factor == 1))
+dbcNumber dbcSignal::Decode(CAN_frame_t* msg)
+  {
+  uint64_t val;
+
+  if (m_dec_direct)
     {
-    result = (result * m_factor);
+    val = msg->data.u64;
+    if (m_byte_order == DBC_BYTEORDER_BIG_ENDIAN)
+      val = __builtin_bswap64(val);
+    val = (val >> m_dec_shift) & m_dec_mask;
     }
-  if (!(m_offset == 0))
+  else if (m_byte_order == DBC_BYTEORDER_BIG_ENDIAN)
+    val = dbc_extract_bits_big_endian(msg->data.u8,m_start_bit,m_signal_size) & m_dec_mask;
+  else
+    val = dbc_extract_bits_little_endian(msg->data.u8,m_start_bit,m_signal_size) & m_dec_mask;
+
+  // Sign extension:
+  if (m_dec_signed && (val >> (m_signal_size-1)) & 1)
+    val |= ~m_dec_mask;
+
+  if (m_dec_integer)
     {
-    result = (result + m_offset);
+    if (m_value_type == DBC_VALUETYPE_UNSIGNED)
+      {
+      uint64_t res = val * (uint64_t)m_dec_ifactor + (uint64_t)m_dec_ioffset;
+      if (res <= UINT32_MAX && m_dec_ifactor >= 0 && m_dec_ioffset >= 0)
+        return dbcNumber((uint32_t)res);
+      return dbcNumber((double)val * m_dec_factor + m_dec_offset);
+      }
+    else
+      {
+      int64_t res = (int64_t)val * m_dec_ifactor + m_dec_ioffset;
+      if (res >= INT32_MIN && res <= INT32_MAX)
+        return dbcNumber((int32_t)res);
+      return dbcNumber((double)(int64_t)val * m_dec_factor + m_dec_offset);
+      }
     }
-
-  return result;
+  else if (m_value_type == DBC_VALUETYPE_UNSIGNED)
+    return dbcNumber((double)val * m_dec_factor + m_dec_offset);
+  else
+    return dbcNumber((double)(int64_t)val * m_dec_factor + m_dec_offset);
   }
 
 void dbcSignal::AssignMetric(OvmsMetric* metric)
@@ -329,6 +329,19 @@ class dbcSignal
     dbcNumber m_maximum;
     std::string m_unit;
     OvmsMetric* m_metric;
+
+  protected:
+    // Precompiled decoder (see PrepareDecoder):
+    void PrepareDecoder();
+    bool m_dec_direct;                // single 64 bit extraction possible
+    bool m_dec_signed;                // sign extend
+    bool m_dec_integer;               // integer scaling (factor & offset integral)
+    uint8_t m_dec_shift;              // LSB position in (byte swapped) payload
+    uint64_t m_dec_mask;              // value mask (m_signal_size bits)
+    double m_dec_factor;
+    double m_dec_offset;
+    int64_t m_dec_ifactor;
+    int64_t m_dec_ioffset;
   };
 
 typedef std::list<dbcSignal*> dbcSignalList_t;
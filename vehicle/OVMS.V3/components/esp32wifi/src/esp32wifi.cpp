@@ -373,12 +373,13 @@ esp32wifi::esp32wifi(const char* name)
 
   using std::placeholders::_1;
   using std::placeholders::_2;
+  using std::placeholders::_3;
   MyEvents.RegisterEvent(TAG,"system.wifi.sta.start",std::bind(&esp32wifi::EventWifiStaState, this, _1, _2));
   MyEvents.RegisterEvent(TAG,"system.wifi.sta.gotip",std::bind(&esp32wifi::EventWifiGotIp, this, _1, _2));
   MyEvents.RegisterEvent(TAG,"system.wifi.sta.lostip",std::bind(&esp32wifi::EventWifiLostIp, this, _1, _2));
   MyEvents.RegisterEvent(TAG,"system.wifi.sta.connected",std::bind(&esp32wifi::EventWifiStaConnected, this, _1, _2));
   MyEvents.RegisterEvent(TAG,"system.wifi.sta.disconnected",std::bind(&esp32wifi::EventWifiStaDisconnected, this, _1, _2));
-  MyEvents.RegisterEvent(TAG,"ticker.1",std::bind(&esp32wifi::EventTimer1, this, _1, _2));
+  MyEvents.RegisterEventId(TAG,"ticker.1",std::bind(&esp32wifi::EventTimer1, this, _1, _2, _3));
   MyEvents.RegisterEvent(TAG,"system.wifi.scan.done",std::bind(&esp32wifi::EventWifiScanDone, this, _1, _2));
   MyEvents.RegisterEvent(TAG,"system.wifi.ap.start",std::bind(&esp32wifi::EventWifiApState, this, _1, _2));
   MyEvents.RegisterEvent(TAG,"system.wifi.ap.stop",std::bind(&esp32wifi::EventWifiApState, this, _1, _2));
@@ -1129,7 +1130,7 @@ void esp32wifi::EventWifiApUpdate(std::string event, void* data)
       info->sta_connected.aid, MAC2STR(info->sta_connected.mac));
   }
 
-void esp32wifi::EventTimer1(std::string event, void* data)
+void esp32wifi::EventTimer1(event_id_t id, const char* event, void* data)
   {
   UpdateNetMetrics();
 
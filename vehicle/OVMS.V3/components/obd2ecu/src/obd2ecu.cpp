@@ -132,7 +132,7 @@ float obd2pid::Execute()
     case Script:
 #ifdef CONFIG_OVMS_SC_JAVASCRIPT_DUKTAPE
       {
-      return MyScripts.DuktapeEvalFloatResult(m_script);
+      return MyScripts.DuktapeEvalFloatResult(m_script, NULL, true);
       }
 #else // #ifdef CONFIG_OVMS_SC_JAVASCRIPT_DUKTAPE
       return 0;
@@ -172,7 +172,13 @@ obd2ecu::obd2ecu(const char* name, canbus* can)
 
   xTaskCreatePinnedToCore(OBD2ECU_task, "OVMS OBDII ECU", 6144, (void*)this, 5, &m_task, CORE(1));
 
-  MyCan.RegisterListener(m_rxqueue);
+  // only queue OBD2 requests & flow control frames from our bus:
+  uint8_t bus = '1' + m_can->m_busnumber;
+  m_rxfilter.AddFilter(bus, REQUEST_PID, REQUEST_PID);
+  m_rxfilter.AddFilter(bus, FLOWCONTROL_PID, FLOWCONTROL_PID);
+  m_rxfilter.AddFilter(bus, REQUEST_EXT_PID, REQUEST_EXT_PID);
+  m_rxfilter.AddFilter(bus, FLOWCONTROL_EXT_PID, FLOWCONTROL_EXT_PID);
+  MyCan.RegisterListener(m_rxqueue, false, &m_rxfilter);
   }
 
 obd2ecu::~obd2ecu()
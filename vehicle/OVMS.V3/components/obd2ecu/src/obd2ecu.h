@@ -86,6 +86,7 @@ class obd2ecu : public pcp, public InternalRamAllocated
 
   public:
     canbus* m_can;
+    canfilter m_rxfilter;
     QueueHandle_t m_rxqueue;
     TaskHandle_t m_task;
     time_t m_starttime;
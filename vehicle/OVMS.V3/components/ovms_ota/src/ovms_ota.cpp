@@ -543,7 +543,8 @@ OvmsOTA::OvmsOTA()
   #undef bind  // Kludgy, but works
   using std::placeholders::_1;
   using std::placeholders::_2;
-  MyEvents.RegisterEvent(TAG,"ticker.600", std::bind(&OvmsOTA::Ticker600, this, _1, _2));
+  using std::placeholders::_3;
+  MyEvents.RegisterEventId(TAG,"ticker.600", std::bind(&OvmsOTA::Ticker600, this, _1, _2, _3));
 
 #ifdef CONFIG_OVMS_COMP_SDCARD
   MyEvents.RegisterEvent(TAG,"sd.mounted", std::bind(&OvmsOTA::AutoFlashSD, this, _1, _2));
@@ -632,7 +633,7 @@ void OvmsOTA::GetStatus(ota_info& info, bool check_update /*=true*/)
     }
   }
 
-void OvmsOTA::Ticker600(std::string event, void* data)
+void OvmsOTA::Ticker600(event_id_t id, const char* event, void* data)
   {
   if (MyConfig.GetParamValueBool("auto", "ota", true) == false)
     return;
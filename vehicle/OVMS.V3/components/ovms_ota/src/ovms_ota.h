@@ -58,7 +58,7 @@ class OvmsOTA
   public:
     void LaunchAutoFlash(bool force=false);
     bool AutoFlash(bool force=false);
-    void Ticker600(std::string event, void* data);
+    void Ticker600(event_id_t id, const char* event, void* data);
 
   public:
     OvmsMutex m_flashing;
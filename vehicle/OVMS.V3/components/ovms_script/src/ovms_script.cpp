@@ -38,6 +38,8 @@ static const char *TAG = "script";
 #include <stdio.h>
 #include <dirent.h>
 #include <esp_task_wdt.h>
+#include <sys/stat.h>
+#include "esp_timer.h"
 #include "ovms_malloc.h"
 #include "ovms_module.h"
 #include "ovms_script.h"
@@ -48,6 +50,8 @@ static const char *TAG = "script";
 #include "buffered_shell.h"
 #include "ovms_netmanager.h"
 #include "ovms_tls.h"
+#include "ovms_utils.h"
+#include "ovms_version.h"
 
 OvmsScripts MyScripts __attribute__ ((init_priority (1600)));
 
@@ -98,6 +102,158 @@ void DuktapeObjectRegistration::RegisterWithDuktape(duk_context* ctx)
   duk_put_global_string(ctx, m_name);
   }
 
+////////////////////////////////////////////////////////////////////////
+// Module bytecode cache
+//  Compiled module functions are saved as "<script>.dbc" next to the
+//  script file (internal modules: in DUKTAPE_BYTECODE_INTDIR), and loaded
+//  instead of compiling the source if the file key (mtime & size) and the
+//  firmware key match. Duktape does not validate bytecode, so the
+//  data is additionally protected by a checksum.
+
+#define DUKTAPE_BYTECODE_MAGIC    0x4342564f    // "OVBC"
+#define DUKTAPE_BYTECODE_EXT      ".dbc"
+#define DUKTAPE_BYTECODE_INTDIR   "/store/scripts/.int/"
+
+typedef struct __attribute__ ((__packed__))
+  {
+  uint32_t magic;                     // DUKTAPE_BYTECODE_MAGIC
+  uint32_t fwhash;                    // firmware key
+  uint32_t mtime;                     // source modification time (0 = internal module)
+  uint32_t size;                      // source size
+  uint32_t length;                    // bytecode length
+  uint32_t checksum;                  // bytecode FNV-1a hash
+  } duktape_bytecode_header_t;
+
+typedef struct
+  {
+  uint32_t fwhash;                    // firmware key for this run
+  int compiled;                       // modules compiled from source
+  int64_t compile_time;               // … time spent [us]
+  int loaded;                         // modules loaded from bytecode
+  int64_t load_time;                  // … time spent [us]
+  int saved;                          // bytecode files written
+  int64_t init_time;                  // DukTapeInit() run time [us]
+  } duktape_modulestats_t;
+
+static duktape_modulestats_t DukOvmsModuleStats;
+
+static uint32_t DukOvmsHash(const void* data, size_t len, uint32_t hash = 2166136261u)
+  {
+  const uint8_t* p = (const uint8_t*) data;
+  for (size_t i = 0; i < len; i++)
+    hash = (hash ^ p[i]) * 16777619u;
+  return hash;
+  }
+
+static void DukOvmsInitModuleStats()
+  {
+  memset(&DukOvmsModuleStats, 0, sizeof(DukOvmsModuleStats));
+  std::string fwkey = GetOVMSVersion();
+  fwkey.append(GetOVMSBuild());
+  uint32_t dukversion = DUK_VERSION;
+  DukOvmsModuleStats.fwhash = DukOvmsHash(&dukversion, sizeof(dukversion),
+    DukOvmsHash(fwkey.data(), fwkey.size()));
+  }
+
+/**
+ * DukOvmsLoadBytecode: push bytecode buffer from cache file
+ *  Returns false (nothing pushed) if the file is missing or doesn't match the key.
+ */
+static bool DukOvmsLoadBytecode(duk_context *ctx, const std::string& dbcpath, uint32_t mtime, uint32_t size)
+  {
+  FILE* bf = fopen(dbcpath.c_str(), "r");
+  if (!bf)
+    return false;
+
+  duktape_bytecode_header_t hdr;
+  if (fread(&hdr, sizeof(hdr), 1, bf) != 1 ||
+      hdr.magic != DUKTAPE_BYTECODE_MAGIC ||
+      hdr.fwhash != DukOvmsModuleStats.fwhash ||
+      hdr.mtime != mtime || hdr.size != size ||
+      hdr.length == 0 ||
+      fseek(bf, 0, SEEK_END) != 0 || ftell(bf) != (long)(sizeof(hdr) + hdr.length) ||
+      fseek(bf, sizeof(hdr), SEEK_SET) != 0)
+    {
+    fclose(bf);
+    return false;
+    }
+
+  void* data = duk_push_fixed_buffer(ctx, hdr.length);
+  bool valid = (fread(data, hdr.length, 1, bf) == 1 &&
+                DukOvmsHash(data, hdr.length) == hdr.checksum);
+  fclose(bf);
+  if (!valid)
+    {
+    ESP_LOGW(TAG, "load_cb: bytecode cache %s corrupted, ignored", dbcpath.c_str());
+    duk_pop(ctx);
+    }
+  return valid;
+  }
+
+/**
+ * DukOvmsSetBytecodeCache: request bytecode cache update by duk__eval_module_source()
+ */
+static void DukOvmsSetBytecodeCache(duk_context *ctx, duk_idx_t module_idx, const std::string& dbcpath, uint32_t mtime, uint32_t size)
+  {
+  duktape_bytecode_header_t* hdr = (duktape_bytecode_header_t*)
+    duk_push_fixed_buffer(ctx, sizeof(duktape_bytecode_header_t));
+  hdr->magic = DUKTAPE_BYTECODE_MAGIC;
+  hdr->fwhash = DukOvmsModuleStats.fwhash;
+  hdr->mtime = mtime;
+  hdr->size = size;
+  duk_put_prop_string(ctx, module_idx, "\xff" "dbcHeader");
+  duk_push_string(ctx, dbcpath.c_str());
+  duk_put_prop_string(ctx, module_idx, "\xff" "dbcPath");
+  }
+
+/**
+ * DukOvmsSaveBytecode: dump function at func_idx to the cache file, if requested
+ */
+static void DukOvmsSaveBytecode(duk_context *ctx, duk_idx_t module_idx, duk_idx_t func_idx)
+  {
+  module_idx = duk_normalize_index(ctx, module_idx);
+  func_idx = duk_normalize_index(ctx, func_idx);
+  if (!duk_get_prop_string(ctx, module_idx, "\xff" "dbcPath"))
+    {
+    duk_pop(ctx);
+    return;
+    }
+  std::string dbcpath = duk_get_string(ctx, -1);
+  duk_get_prop_string(ctx, module_idx, "\xff" "dbcHeader");
+  duktape_bytecode_header_t hdr;
+  memcpy(&hdr, duk_require_buffer_data(ctx, -1, NULL), sizeof(hdr));
+  duk_pop_2(ctx);
+
+  duk_dup(ctx, func_idx);
+  duk_dump_function(ctx);
+  duk_size_t len;
+  void* data = duk_get_buffer_data(ctx, -1, &len);
+  hdr.length = len;
+  hdr.checksum = DukOvmsHash(data, len);
+
+  if (startsWith(dbcpath, DUKTAPE_BYTECODE_INTDIR))
+    mkpath(DUKTAPE_BYTECODE_INTDIR);
+  FILE* bf = fopen(dbcpath.c_str(), "w");
+  bool ok = (bf != NULL);
+  if (bf)
+    {
+    ok = (fwrite(&hdr, sizeof(hdr), 1, bf) == 1 && fwrite(data, len, 1, bf) == 1);
+    ok = (fclose(bf) == 0) && ok;
+    }
+  duk_pop(ctx);
+
+  if (ok)
+    {
+    ESP_LOGD(TAG, "Duktape: saved bytecode cache %s (%u bytes)", dbcpath.c_str(), (unsigned)len);
+    DukOvmsModuleStats.saved++;
+    }
+  else
+    {
+    ESP_LOGW(TAG, "Duktape: cannot write bytecode cache %s", dbcpath.c_str());
+    unlink(dbcpath.c_str());
+    }
+  }
+
 static duk_int_t duk__eval_module_source(duk_context *ctx, void *udata);
 static void duk__push_module_object(duk_context *ctx, const char *id, duk_bool_t main);
 
@@ -211,11 +367,11 @@ static duk_ret_t duk__handle_require(duk_context *ctx)
 		duk_throw(ctx);  /* rethrow */
 	  }
 
-	if (duk_is_string(ctx, -1))
+	if (duk_is_string(ctx, -1) || duk_is_buffer_data(ctx, -1))
     {
 		duk_int_t ret;
 
-		/* [ ... module source ] */
+		/* [ ... module source ] (OVMS: or [ ... module bytecode ]) */
 		ret = duk_safe_call(ctx, duk__eval_module_source, NULL, 2, 1);
 		if (ret != DUK_EXEC_SUCCESS)
       {
@@ -302,29 +458,46 @@ static void duk__push_module_object(duk_context *ctx, const char *id, duk_bool_t
 static duk_int_t duk__eval_module_source(duk_context *ctx, void *udata)
   {
 	const char *src;
+	int64_t starttime = esp_timer_get_time();
 
 	/*
-	 *  Stack: [ ... module source ]
+	 *  Stack: [ ... module source ] (OVMS: or [ ... module bytecode ])
 	 */
 
 	(void) udata;
 
-	/* Wrap the module code in a function expression.  This is the simplest
-	 * way to implement CommonJS closure semantics and matches the behavior of
-	 * e.g. Node.js.
-	 */
-	duk_push_string(ctx, "(function(exports,require,module,__filename,__dirname){");
-	src = duk_require_string(ctx, -2);
-	duk_push_string(ctx, (src[0] == '#' && src[1] == '!') ? "//" : "");  /* Shebang support. */
-	duk_dup(ctx, -3);  /* source */
-	duk_push_string(ctx, "\n})");  /* Newline allows module last line to contain a // comment. */
-	duk_concat(ctx, 4);
-
-	/* [ ... module source func_src ] */
-
-	(void) duk_get_prop_string(ctx, -3, "filename");
-	duk_compile(ctx, DUK_COMPILE_EVAL);
-	duk_call(ctx, 0);
+	if (duk_is_buffer_data(ctx, -1))
+	  {
+		/* OVMS: load the wrapper function from the bytecode cache */
+		duk_dup(ctx, -1);
+		duk_load_function(ctx);
+		DukOvmsModuleStats.loaded++;
+		DukOvmsModuleStats.load_time += esp_timer_get_time() - starttime;
+	  }
+	else
+	  {
+		/* Wrap the module code in a function expression.  This is the simplest
+		 * way to implement CommonJS closure semantics and matches the behavior of
+		 * e.g. Node.js.
+		 */
+		duk_push_string(ctx, "(function(exports,require,module,__filename,__dirname){");
+		src = duk_require_string(ctx, -2);
+		duk_push_string(ctx, (src[0] == '#' && src[1] == '!') ? "//" : "");  /* Shebang support. */
+		duk_dup(ctx, -3);  /* source */
+		duk_push_string(ctx, "\n})");  /* Newline allows module last line to contain a // comment. */
+		duk_concat(ctx, 4);
+
+		/* [ ... module source func_src ] */
+
+		(void) duk_get_prop_string(ctx, -3, "filename");
+		duk_compile(ctx, DUK_COMPILE_EVAL);
+		duk_call(ctx, 0);
+		DukOvmsModuleStats.compiled++;
+		DukOvmsModuleStats.compile_time += esp_timer_get_time() - starttime;
+
+		/* OVMS: update the bytecode cache */
+		DukOvmsSaveBytecode(ctx, -3, -1);
+	  }
 
 	/* [ ... module source func ] */
 
@@ -356,18 +529,31 @@ static duk_int_t duk__eval_module_source(duk_context *ctx, void *udata)
 	return 1;
   }
 
-/* Load a module as the 'main' module. */
+/* Load a module as the 'main' module.
+ * OVMS: the module code is provided by the module load callback, as for require().
+ */
 duk_ret_t duk_module_node_peval_main(duk_context *ctx, const char *path)
   {
 	/*
-	 *  Stack: [ ... source ]
+	 *  Stack: [ ... ]
 	 */
 
+	duk_push_global_stash(ctx);
 	duk__push_module_object(ctx, path, 1 /*main*/);
-	/* [ ... source module ] */
-
-	duk_dup(ctx, 0);
-	/* [ ... source module source ] */
+	/* [ ... stash module ] */
+
+	(void) duk_get_prop_string(ctx, -2, "\xff" "modLoad");
+	duk_push_string(ctx, path);
+	(void) duk_get_prop_string(ctx, -3, "exports");
+	duk_dup(ctx, -4);
+	if (duk_pcall(ctx, 3) != DUK_EXEC_SUCCESS)
+	  {
+		duk_replace(ctx, -3);
+		duk_pop(ctx);
+		return DUK_EXEC_ERROR;
+	  }
+	duk_remove(ctx, -3);
+	/* [ ... module source ] */
 
 	return duk_safe_call(ctx, duk__eval_module_source, NULL, 2, 1);
   }
@@ -521,8 +707,19 @@ static duk_ret_t DukOvmsLoadModule(duk_context *ctx)
       }
     else
       {
-      ESP_LOGD(TAG,"load_cb: id:'%s' internally provided %s (%d bytes)", module_id, filename, mod->length);
-      duk_push_lstring(ctx, mod->start, mod->length);
+      std::string dbcpath(DUKTAPE_BYTECODE_INTDIR);
+      dbcpath.append(module_id+4);
+      dbcpath.append(DUKTAPE_BYTECODE_EXT);
+      if (DukOvmsLoadBytecode(ctx, dbcpath, 0, mod->length))
+        {
+        ESP_LOGD(TAG,"load_cb: id:'%s' internally provided %s (bytecode)", module_id, filename);
+        }
+      else
+        {
+        ESP_LOGD(TAG,"load_cb: id:'%s' internally provided %s (%d bytes)", module_id, filename, mod->length);
+        DukOvmsSetBytecodeCache(ctx, 2, dbcpath, 0, mod->length);
+        duk_push_lstring(ctx, mod->start, mod->length);
+        }
       MyCommandApp.NotifyDuktapeModuleLoad(filename);
       return 1;
       }
@@ -532,13 +729,27 @@ static duk_ret_t DukOvmsLoadModule(duk_context *ctx)
 
   std::string path = std::string("/store/scripts/");
   path.append(filename);
-  FILE* sf = fopen(path.c_str(), "r");
-  if (sf == NULL)
+  struct stat st;
+  if (stat(path.c_str(), &st) != 0)
     {
     path = std::string("/sd/scripts/");
     path.append(filename);
-    sf = fopen(path.c_str(), "r");
+    if (stat(path.c_str(), &st) != 0)
+      {
+      duk_error(ctx, DUK_ERR_TYPE_ERROR, "load_cb: cannot find module: %s", module_id);
+      return 0;
+      }
+    }
+
+  std::string dbcpath = path + DUKTAPE_BYTECODE_EXT;
+  if (DukOvmsLoadBytecode(ctx, dbcpath, st.st_mtime, st.st_size))
+    {
+    ESP_LOGD(TAG,"load_cb: id:'%s' vfs provided %s (bytecode)", module_id, filename);
+    MyCommandApp.NotifyDuktapeModuleLoad(filename);
+    return 1;
     }
+
+  FILE* sf = fopen(path.c_str(), "r");
   if (sf == NULL)
     {
     duk_error(ctx, DUK_ERR_TYPE_ERROR, "load_cb: cannot find module: %s", module_id);
@@ -546,6 +757,7 @@ static duk_ret_t DukOvmsLoadModule(duk_context *ctx)
     }
   else
     {
+    DukOvmsSetBytecodeCache(ctx, 2, dbcpath, st.st_mtime, st.st_size);
     fseek(sf,0,SEEK_END);
     long slen = ftell(sf);
     fseek(sf,0,SEEK_SET);
@@ -2075,7 +2287,12 @@ void OvmsScripts::DuktapeEvalNoResult(const char* text, OvmsWriter* writer, cons
   DuktapeDispatchWait(&dmsg);
   }
 
-float OvmsScripts::DuktapeEvalFloatResult(const char* text, OvmsWriter* writer)
+/**
+ * DuktapeEvalFloatResult / DuktapeEvalIntResult: execute script text, return result
+ *  Set cache=true for texts evaluated repeatedly (e.g. OBD2ECU PID scripts): the
+ *  compiled function is kept in the Duktape heap, so the text is only parsed once.
+ */
+float OvmsScripts::DuktapeEvalFloatResult(const char* text, OvmsWriter* writer, bool cache /*=false*/)
   {
   float result = 0;
   duktape_queue_t dmsg;
@@ -2084,11 +2301,12 @@ float OvmsScripts::DuktapeEvalFloatResult(const char* text, OvmsWriter* writer)
   dmsg.writer = writer;
   dmsg.body.dt_evalfloatresult.text = text;
   dmsg.body.dt_evalfloatresult.result = &result;
+  dmsg.body.dt_evalfloatresult.cache = cache;
   DuktapeDispatchWait(&dmsg);
   return result;
   }
 
-int OvmsScripts::DuktapeEvalIntResult(const char* text, OvmsWriter* writer)
+int OvmsScripts::DuktapeEvalIntResult(const char* text, OvmsWriter* writer, bool cache /*=false*/)
   {
   int result = 0;
   duktape_queue_t dmsg;
@@ -2097,10 +2315,85 @@ int OvmsScripts::DuktapeEvalIntResult(const char* text, OvmsWriter* writer)
   dmsg.writer = writer;
   dmsg.body.dt_evalintresult.text = text;
   dmsg.body.dt_evalintresult.result = &result;
+  dmsg.body.dt_evalintresult.cache = cache;
   DuktapeDispatchWait(&dmsg);
   return result;
   }
 
+/**
+ * DuktapePushCompiled: compile script text, push function (Duktape task only)
+ *  With cache=true, compiled functions are kept in the heap stash object "evalcache",
+ *  keyed by the FNV-1a hash of the text. Entries are [text, function] to verify the
+ *  text on hash collisions. The cache is reset when exceeding DUKTAPE_EVALCACHE_SIZE.
+ *  Returns false on compile errors, with the error pushed instead.
+ */
+bool OvmsScripts::DuktapePushCompiled(const char* text, bool cache)
+  {
+  duk_context* ctx = m_dukctx;
+  size_t len = strlen(text);
+  uint32_t hash = 2166136261u;
+  if (cache)
+    {
+    for (size_t i = 0; i < len; i++)
+      hash = (hash ^ (uint8_t)text[i]) * 16777619u;
+
+    duk_push_heap_stash(ctx);
+    if (!duk_get_prop_string(ctx, -1, "evalcache") || m_evalcache_count >= DUKTAPE_EVALCACHE_SIZE)
+      {
+      duk_pop(ctx);
+      duk_push_bare_object(ctx);
+      duk_dup_top(ctx);
+      duk_put_prop_string(ctx, -3, "evalcache");
+      m_evalcache_count = 0;
+      }
+    // stack: [stash cache]
+    if (duk_get_prop_index(ctx, -1, hash))
+      {
+      duk_size_t srclen;
+      duk_get_prop_index(ctx, -1, 0);
+      const char* src = duk_get_lstring(ctx, -1, &srclen);
+      if (src && srclen == len && memcmp(src, text, len) == 0)
+        {
+        // cache hit:
+        duk_pop(ctx);
+        duk_get_prop_index(ctx, -1, 1);
+        duk_replace(ctx, -4);
+        duk_pop_2(ctx);
+        return true;
+        }
+      duk_pop(ctx);
+      }
+    duk_pop(ctx);
+    }
+
+  duk_push_lstring(ctx, text, len);
+  duk_push_string(ctx, "eval");
+  if (duk_pcompile(ctx, DUK_COMPILE_EVAL) != 0)
+    {
+    if (cache)
+      {
+      duk_replace(ctx, -3);
+      duk_pop(ctx);
+      }
+    return false;
+    }
+
+  if (cache)
+    {
+    // stack: [stash cache function]
+    duk_push_array(ctx);
+    duk_push_lstring(ctx, text, len);
+    duk_put_prop_index(ctx, -2, 0);
+    duk_dup(ctx, -2);
+    duk_put_prop_index(ctx, -2, 1);
+    duk_put_prop_index(ctx, -3, hash);
+    m_evalcache_count++;
+    duk_replace(ctx, -3);
+    duk_pop(ctx);
+    }
+  return true;
+  }
+
 void OvmsScripts::DuktapeReload()
   {
   duktape_queue_t dmsg;
@@ -2138,12 +2431,16 @@ void *DukAlloc(void *udata, duk_size_t size)
 
 void OvmsScripts::DukTapeInit()
   {
+  DukOvmsInitModuleStats();
+  int64_t starttime = esp_timer_get_time();
+
   ESP_LOGI(TAG,"Duktape: Creating heap");
   m_dukctx = duk_create_heap(DukOvmsAlloc,
     DukOvmsRealloc,
     DukOvmsFree,
     this,
     DukOvmsFatalHandler);
+  m_evalcache_count = 0;
 
   ESP_LOGI(TAG,"Duktape: Initialising module system");
   duk_push_object(m_dukctx);
@@ -2207,23 +2504,22 @@ void OvmsScripts::DukTapeInit()
     }
 
   // ovmsmain
-  FILE* sf = fopen("/store/scripts/ovmsmain.js", "r");
-  if (sf != NULL)
+  if (path_exists("/store/scripts/ovmsmain.js"))
     {
-    fseek(sf,0,SEEK_END);
-    long slen = ftell(sf);
-    fseek(sf,0,SEEK_SET);
-    char *script = new char[slen+1];
-    memset(script,0,slen+1);
-    fread(script,1,slen,sf);
-    duk_push_string(m_dukctx, script);
-    delete [] script;
-    fclose(sf);
     ESP_LOGI(TAG,"Duktape: Executing ovmsmain.js");
-    MyCommandApp.NotifyDuktapeModuleLoad("ovmsmain.js");
-    duk_module_node_peval_main(m_dukctx, "ovmsmain.js");
+    if (duk_module_node_peval_main(m_dukctx, "ovmsmain.js") != 0)
+      {
+      DukOvmsErrorHandler(m_dukctx, -1, NULL, "ovmsmain.js");
+      }
+    duk_pop(m_dukctx);
     MyCommandApp.NotifyDuktapeModuleUnload("ovmsmain.js");
     }
+
+  DukOvmsModuleStats.init_time = esp_timer_get_time() - starttime;
+  ESP_LOGI(TAG,"Duktape: Initialised in %u ms, compiled %d modules in %u ms, loaded %d from bytecode in %u ms",
+    (uint32_t)(DukOvmsModuleStats.init_time / 1000),
+    DukOvmsModuleStats.compiled, (uint32_t)(DukOvmsModuleStats.compile_time / 1000),
+    DukOvmsModuleStats.loaded, (uint32_t)(DukOvmsModuleStats.load_time / 1000));
   }
 
 void OvmsScripts::DukTapeTask()
@@ -2320,8 +2616,8 @@ void OvmsScripts::DukTapeTask()
           if (m_dukctx != NULL)
             {
             // Execute script text (float result)
-            duk_push_string(m_dukctx, msg.body.dt_evalfloatresult.text);
-            if (duk_peval(m_dukctx) != 0)
+            if (!DuktapePushCompiled(msg.body.dt_evalfloatresult.text, msg.body.dt_evalfloatresult.cache) ||
+                duk_pcall(m_dukctx, 0) != 0)
               {
               DukOvmsErrorHandler(m_dukctx, -1, msg.writer);
               *msg.body.dt_evalfloatresult.result = 0;
@@ -2345,8 +2641,8 @@ void OvmsScripts::DukTapeTask()
           if (m_dukctx != NULL)
             {
             // Execute script text (int result)
-            duk_push_string(m_dukctx, msg.body.dt_evalintresult.text);
-            if (duk_peval(m_dukctx) != 0)
+            if (!DuktapePushCompiled(msg.body.dt_evalintresult.text, msg.body.dt_evalintresult.cache) ||
+                duk_pcall(m_dukctx, 0) != 0)
               {
               DukOvmsErrorHandler(m_dukctx, -1, msg.writer);
               *msg.body.dt_evalintresult.result = 0;
@@ -2392,6 +2688,13 @@ static void script_reload(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, i
   {
   writer->puts("Reloading javascript engine");
   MyScripts.DuktapeReload();
+  writer->printf("Initialised in %u ms\n"
+    "  compiled from source: %d modules in %u ms (%d bytecode files updated)\n"
+    "  loaded from bytecode: %d modules in %u ms\n",
+    (uint32_t)(DukOvmsModuleStats.init_time / 1000),
+    DukOvmsModuleStats.compiled, (uint32_t)(DukOvmsModuleStats.compile_time / 1000),
+    DukOvmsModuleStats.saved,
+    DukOvmsModuleStats.loaded, (uint32_t)(DukOvmsModuleStats.load_time / 1000));
   }
 
 static void script_eval(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv)
@@ -2532,16 +2835,84 @@ void OvmsScripts::AllScripts(std::string path)
     }
   }
 
-void OvmsScripts::EventScript(std::string event, void* data)
+void OvmsScripts::EventScriptIndexClear()
   {
-  std::string path;
+  for (auto it = m_evscripts.begin(); it != m_evscripts.end(); it++)
+    free((void*)it->first);
+  m_evscripts.clear();
+  }
+
+void OvmsScripts::EventScriptIndexScan(const char* path, uint8_t storage)
+  {
+  DIR *dir;
+  struct dirent *dp;
+
+  if ((dir = opendir(path)) == NULL)
+    return;
+  while ((dp = readdir(dir)) != NULL)
+    {
+    if (dp->d_type != DT_DIR)
+      continue;
+    auto it = m_evscripts.find(dp->d_name);
+    if (it != m_evscripts.end())
+      it->second |= storage;
+    else
+      m_evscripts[strdup(dp->d_name)] = storage;
+    }
+  closedir(dir);
+  }
+
+/**
+ * EventScriptIndexBuild: (re)read the event script directories
+ *  The index holds the names of all event subdirectories, so the event task
+ *  only needs to access the file system for events that actually have scripts.
+ */
+void OvmsScripts::EventScriptIndexBuild()
+  {
+  EventScriptIndexClear();
+#ifdef CONFIG_OVMS_DEV_SDCARDSCRIPTS
+  EventScriptIndexScan("/sd/events", EVENTSCRIPT_SD);
+#endif // #ifdef CONFIG_OVMS_DEV_SDCARDSCRIPTS
+  EventScriptIndexScan("/store/events", EVENTSCRIPT_STORE);
+  m_evscripts_valid = true;
+  ESP_LOGD(TAG, "EventScriptIndexBuild: %u event script directories", m_evscripts.size());
+  }
+
+/**
+ * EventScriptIndexCheck: invalidate the index on storage changes
+ *  File changes are signalled by the VFS commands, the editor and the web UI.
+ *  FAT does not update directory mtimes on content changes, so other writers
+ *  (scp, scripts) are covered by a periodic rescan once per minute.
+ */
+void OvmsScripts::EventScriptIndexCheck(const char* event, void* data)
+  {
+  if (!m_evscripts_valid)
+    return;
+  if (strcmp(event, "ticker.60") == 0 ||
+      strcmp(event, "sd.mounted") == 0 ||
+      strcmp(event, "sd.unmounted") == 0 ||
+      strcmp(event, "config.mounted") == 0)
+    {
+    m_evscripts_valid = false;
+    }
+  else if (strcmp(event, "system.vfs.file.changed") == 0)
+    {
+    const char* path = (const char*)data;
+    if (path == NULL ||
+        strncmp(path, "/store/events", 13) == 0 ||
+        strncmp(path, "/sd/events", 10) == 0)
+      m_evscripts_valid = false;
+    }
+  }
 
+void OvmsScripts::EventScript(const char* event, void* data)
+  {
 #ifdef CONFIG_OVMS_SC_JAVASCRIPT_DUKTAPE
   // dispatch event to PubSub component:
   duktape_queue_t dmsg;
   memset(&dmsg, 0, sizeof(dmsg));
   dmsg.type = DUKTAPE_event;
-  dmsg.body.dt_event.name = strdup(event.c_str());
+  dmsg.body.dt_event.name = strdup(event);
   dmsg.body.dt_event.data = NULL; // data unused, may also be invalid in async script execution
   if (!DuktapeDispatch(&dmsg, 0))
     {
@@ -2549,20 +2920,38 @@ void OvmsScripts::EventScript(std::string event, void* data)
     }
 #endif // #ifdef CONFIG_OVMS_SC_JAVASCRIPT_DUKTAPE
 
+  // lookup event script directories:
+  EventScriptIndexCheck(event, data);
+  if (!m_evscripts_valid)
+    EventScriptIndexBuild();
+  auto it = m_evscripts.find(event);
+  uint8_t storage = (it != m_evscripts.end()) ? it->second : 0;
+
+  if (storage)
+    {
+    std::string path;
+
 #ifdef CONFIG_OVMS_DEV_SDCARDSCRIPTS
-  // run event scripts on external storage:
-  path=std::string("/sd/events/");
-  path.append(event);
-  AllScripts(path);
+    // run event scripts on external storage:
+    if (storage & EVENTSCRIPT_SD)
+      {
+      path = "/sd/events/";
+      path.append(event);
+      AllScripts(path);
+      }
 #endif // #ifdef CONFIG_OVMS_DEV_SDCARDSCRIPTS
 
-  // run event scripts on internal storage:
-  path=std::string("/store/events/");
-  path.append(event);
-  AllScripts(path);
+    // run event scripts on internal storage:
+    if (storage & EVENTSCRIPT_STORE)
+      {
+      path = "/store/events/";
+      path.append(event);
+      AllScripts(path);
+      }
+    }
 
 #ifdef CONFIG_OVMS_SC_JAVASCRIPT_DUKTAPE
-  if (event == "ticker.60")
+  if (strcmp(event, "ticker.60") == 0)
     {
     // request garbage collection once per minute:
     DuktapeCompact(false);
@@ -2573,10 +2962,12 @@ void OvmsScripts::EventScript(std::string event, void* data)
 OvmsScripts::OvmsScripts()
   {
   ESP_LOGI(TAG, "Initialising SCRIPTS (1600)");
+  m_evscripts_valid = false;
 #ifdef CONFIG_OVMS_SC_JAVASCRIPT_DUKTAPE
   m_dukctx = NULL;
   m_duktaskid = NULL;
   m_duktaskqueue = NULL;
+  m_evalcache_count = 0;
 #endif // CONFIG_OVMS_SC_JAVASCRIPT_DUKTAPE
 
 #ifdef CONFIG_OVMS_SC_JAVASCRIPT_NONE
@@ -2643,6 +3034,7 @@ OvmsScripts::OvmsScripts()
 
 OvmsScripts::~OvmsScripts()
   {
+  EventScriptIndexClear();
 #ifdef CONFIG_OVMS_SC_JAVASCRIPT_DUKTAPE
   duk_destroy_heap(m_dukctx);
   m_dukctx = NULL;
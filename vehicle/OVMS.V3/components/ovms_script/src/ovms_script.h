@@ -31,6 +31,7 @@
 #ifndef __SCRIPT_H__
 #define __SCRIPT_H__
 
+#include <map>
 #include "ovms_command.h"
 #include "ovms_utils.h"
 #include "freertos/FreeRTOS.h"
@@ -43,6 +44,8 @@
 #include <list>
 #include <utility>
 
+#define DUKTAPE_EVALCACHE_SIZE  32    // Max compiled scripts cached by DuktapeEval…Result(…, cache=true)
+
 /**
  * DukContext: C++ wrapper for duk_context
  */
@@ -148,11 +151,13 @@ typedef struct
       {
       const char* text;
       float* result;
+      bool cache;
       } dt_evalfloatresult;
     struct
       {
       const char* text;
       int* result;
+      bool cache;
       } dt_evalintresult;
     struct
       {
@@ -316,6 +321,11 @@ class DuktapeHTTPRequest : public DuktapeObject
 
 #endif //#ifdef CONFIG_OVMS_SC_JAVASCRIPT_DUKTAPE
 
+// Event script directory index: event name → storage bits
+#define EVENTSCRIPT_STORE   0x01    // /store/events/<event> exists
+#define EVENTSCRIPT_SD      0x02    // /sd/events/<event> exists
+typedef std::map<const char*, uint8_t, CmpStrOp> EventScriptMap;
+
 class OvmsScripts
   {
   public:
@@ -323,9 +333,19 @@ class OvmsScripts
     ~OvmsScripts();
 
   public:
-    void EventScript(std::string event, void* data);
+    void EventScript(const char* event, void* data);
     void AllScripts(std::string path);
 
+  protected:
+    void EventScriptIndexCheck(const char* event, void* data);
+    void EventScriptIndexScan(const char* path, uint8_t storage);
+    void EventScriptIndexBuild();
+    void EventScriptIndexClear();
+
+  protected:
+    EventScriptMap m_evscripts;             // event dirs containing scripts
+    bool m_evscripts_valid;                 // index valid, else rebuild on next event
+
 #ifdef CONFIG_OVMS_SC_JAVASCRIPT_DUKTAPE
   public:
     void RegisterDuktapeFunction(duk_c_function func, duk_idx_t nargs, const char* name);
@@ -340,8 +360,8 @@ class OvmsScripts
 
   public:
     void  DuktapeEvalNoResult(const char* text, OvmsWriter* writer=NULL, const char* filename=NULL);
-    float DuktapeEvalFloatResult(const char* text, OvmsWriter* writer=NULL);
-    int   DuktapeEvalIntResult(const char* text, OvmsWriter* writer=NULL);
+    float DuktapeEvalFloatResult(const char* text, OvmsWriter* writer=NULL, bool cache=false);
+    int   DuktapeEvalIntResult(const char* text, OvmsWriter* writer=NULL, bool cache=false);
     void  DuktapeReload();
     void  DuktapeCompact(bool wait=true);
     void  DuktapeRequestCallback(DuktapeObject* instance, const char* method, void* data);
@@ -351,6 +371,9 @@ class OvmsScripts
     void DukTapeTask();
     bool DukTapeAvailable() { return m_dukctx != NULL; }
 
+  protected:
+    bool DuktapePushCompiled(const char* text, bool cache);
+
   protected:
     duk_context* m_dukctx;
     TaskHandle_t m_duktaskid;
@@ -358,6 +381,7 @@ class OvmsScripts
     DuktapeFunctionMap m_fnmap;
     DuktapeModuleMap m_modmap;
     DuktapeObjectMap m_obmap;
+    int m_evalcache_count;                // compiled scripts in heap stash cache
 #endif // #ifdef CONFIG_OVMS_SC_JAVASCRIPT_DUKTAPE
   };
 
@@ -266,17 +266,9 @@ void OvmsServerV2::ProcessServerMsg()
     ESP_LOGI(TAG, "Shared secret key is %s (%d bytes)",key.c_str(),key.length());
     hmac_md5((uint8_t*)key.c_str(), key.length(), (uint8_t*)m_password.c_str(), m_password.length(), sdigest);
     RC4_setup(&m_crypto_rx1, &m_crypto_rx2, sdigest, OVMS_MD5_SIZE);
-    for (int k=0;k<1024;k++)
-      {
-      uint8_t v = 0;
-      RC4_crypt(&m_crypto_rx1, &m_crypto_rx2, &v, 1);
-      }
+    RC4_skip(&m_crypto_rx1, &m_crypto_rx2, 1024);
     RC4_setup(&m_crypto_tx1, &m_crypto_tx2, sdigest, OVMS_MD5_SIZE);
-    for (int k=0;k<1024;k++)
-      {
-      uint8_t v = 0;
-      RC4_crypt(&m_crypto_tx1, &m_crypto_tx2, &v, 1);
-      }
+    RC4_skip(&m_crypto_tx1, &m_crypto_tx2, 1024);
 
     if (m_paranoid)
       {
@@ -301,6 +293,11 @@ void OvmsServerV2::ProcessServerMsg()
       // Generate, and store, the digest for future use
       std::string modpass = MyConfig.GetParamValue("password","module");
       hmac_md5((uint8_t*) token, OVMS_PROTOCOL_V2_TOKENSIZE, (uint8_t*)modpass.c_str(), modpass.length(), m_pdigest);
+
+      // Every paranoid message starts with a fresh cipher from the digest,
+      // so precompute the initial state once:
+      RC4_setup(&m_pcrypto1, &m_pcrypto2, m_pdigest, OVMS_MD5_SIZE);
+      RC4_skip(&m_pcrypto1, &m_pcrypto2, 1024);
       }
 
     m_pending_notify_info = true;
@@ -345,15 +342,9 @@ void OvmsServerV2::ProcessServerMsg()
     uint8_t *d = new uint8_t[line.length()-6];
     len = base64decode(line.c_str()+7,d+1);
 
-    RC4_CTX1* pm_crypto1 = new RC4_CTX1;
-    RC4_CTX2* pm_crypto2 = new RC4_CTX2;
-    RC4_setup(pm_crypto1, pm_crypto2, m_pdigest, OVMS_MD5_SIZE);
-    for (int k=0;k<1024;k++)
-      {
-      uint8_t zero = 0;
-      RC4_crypt(pm_crypto1, pm_crypto2, &zero, 1);
-      }
-    RC4_crypt(pm_crypto1, pm_crypto2, d, len);
+    RC4_CTX1 pm_crypto1 = m_pcrypto1;
+    RC4_CTX2 pm_crypto2 = m_pcrypto2;
+    RC4_crypt(&pm_crypto1, &pm_crypto2, d, len);
 
     line.erase(5);
     line = std::string("MP-0 ");
@@ -361,9 +352,7 @@ void OvmsServerV2::ProcessServerMsg()
     line.append((char*)d);
     len = line.length();
 
-    delete pm_crypto1;
-    delete pm_crypto2;
-    delete d;
+    delete [] d;
     ESP_LOGI(TAG, "Decoded Paranoid Msg: %s",line.c_str());
     }
 
@@ -727,54 +716,62 @@ void OvmsServerV2::Transmit(const std::string& message)
   if (!m_mgconn)
     return;
 
-  int len = message.length();
-  char* s = new char[(len*2)+4];
-  memcpy(s,message.c_str(),len);
   ESP_LOGI(TAG, "Send %s",message.c_str());
 
-  if ((m_ptoken_ready)&&
-      (s[5] != 'E')&&
-      (s[5] != 'A')&&
-      (s[5] != 'a')&&
-      (s[5] != 'g')&&
-      (s[5] != 'P'))
+  // Messages are encoded in place in m_txbuf. Each base64 encoding step reads
+  //  its input from behind the output position, which is safe as long as the
+  //  input starts at least one block count (len/3) after the output.
+  int len = message.length();
+  bool paranoid = (m_ptoken_ready)&&
+      (len > 5)&&
+      (message[5] != 'E')&&
+      (message[5] != 'A')&&
+      (message[5] != 'a')&&
+      (message[5] != 'g')&&
+      (message[5] != 'P');
+
+  // The message is of the form MP-0 X...
+  // Where X is the code and ... is the (optional) data
+  // In paranoid mode, this is sent as MP-0 EMX<base64 encrypted data>
+  int plen = paranoid ? len-6 : 0;
+  int tlen = paranoid ? 8 + howmany(plen,3)*4 : len;
+  int toff = howmany(tlen,3);
+  size_t size = toff*4 + 3;
+  if (size > m_txbufsize)
+    {
+    if (m_txbuf) delete [] m_txbuf;
+    m_txbufsize = (size + 255) & ~255;
+    m_txbuf = new uint8_t[m_txbufsize];
+    }
+  uint8_t* t = m_txbuf + toff;
+
+  if (paranoid)
     {
     // We must convert the message to a paranoid one...
-    // The message is of the form MP-0 X...
-    // Where X is the code and ... is the (optional) data
-    char code[2]; code[0] = s[5]; code[1] = 0;
-    uint8_t* d = new uint8_t[len-6];
-    memcpy(d,s+6,len-6);
+    uint8_t* d = t + 8 + howmany(plen,3);
+    memcpy(d, message.data()+6, plen);
 
     // Paranoid encrypt the message part of the transaction
-    RC4_CTX1* pm_crypto1 = new RC4_CTX1;
-    RC4_CTX2* pm_crypto2 = new RC4_CTX2;
-    RC4_setup(pm_crypto1, pm_crypto2, m_pdigest, OVMS_MD5_SIZE);
-    for (int k=0;k<1024;k++)
-      {
-      uint8_t zero = 0;
-      RC4_crypt(pm_crypto1, pm_crypto2, &zero, 1);
-      }
-    RC4_crypt(pm_crypto1, pm_crypto2, d, len-6);
-
-    strcpy(s,"MP-0 EM");
-    strcat(s,code);
-    base64encode(d, len-6, (uint8_t*)s+8);
-    // The messdage is now in paranoid mode...
-    delete d;
-    delete pm_crypto1;
-    delete pm_crypto2;
+    RC4_CTX1 pm_crypto1 = m_pcrypto1;
+    RC4_CTX2 pm_crypto2 = m_pcrypto2;
+    RC4_crypt(&pm_crypto1, &pm_crypto2, d, plen);
+
+    memcpy(t, "MP-0 EM", 7);
+    t[7] = message[5];
+    base64encode(d, plen, t+8);
+    // The message is now in paranoid mode...
+    }
+  else
+    {
+    memcpy(t, message.data(), len);
     }
 
-  RC4_crypt(&m_crypto_tx1, &m_crypto_tx2, (uint8_t*)s, len);
+  RC4_crypt(&m_crypto_tx1, &m_crypto_tx2, t, tlen);
 
-  char* buf = new char[(len*2)+4];
-  base64encode((uint8_t*)s, len, (uint8_t*)buf);
+  char* buf = (char*)m_txbuf;
+  base64encode(t, tlen, m_txbuf);
   strcat(buf,"\r\n");
-  mg_send(m_mgconn, buf, strlen(buf));
-
-  delete [] buf;
-  delete [] s;
+  mg_send(m_mgconn, buf, toff*4 + 2);
   }
 
 void OvmsServerV2::SetStatus(const char* status, bool fault, State newstate)
@@ -884,6 +881,12 @@ void OvmsServerV2::Disconnect()
     m_mgconn = NULL;
     }
   m_buffer->EmptyAll();
+  if (m_txbuf)
+    {
+    delete [] m_txbuf;
+    m_txbuf = NULL;
+    m_txbufsize = 0;
+    }
   m_connretry = 0;
   StandardMetrics.ms_s_v2_connected->SetValue(false);
   StandardMetrics.ms_s_v2_peers->SetValue(0);
@@ -1816,7 +1819,7 @@ void OvmsServerV2::NetmanStop(std::string event, void* data)
     }
   }
 
-void OvmsServerV2::Ticker1(std::string event, void* data)
+void OvmsServerV2::Ticker1(event_id_t id, const char* event, void* data)
   {
   if (m_connretry > 0)
     {
@@ -1904,6 +1907,8 @@ OvmsServerV2::OvmsServerV2(const char* name)
     }
 
   m_buffer = new OvmsBuffer(1024);
+  m_txbuf = NULL;
+  m_txbufsize = 0;
   SetStatus("Server has been started", false, WaitNetwork);
   m_now_stat = false;
   m_now_gps = false;
@@ -1938,6 +1943,7 @@ OvmsServerV2::OvmsServerV2(const char* name)
   #undef bind  // Kludgy, but works
   using std::placeholders::_1;
   using std::placeholders::_2;
+  using std::placeholders::_3;
   MyMetrics.RegisterListener(TAG, "*", std::bind(&OvmsServerV2::MetricModified, this, _1));
 
   if (MyOvmsServerV2Reader == 0)
@@ -1957,7 +1963,7 @@ OvmsServerV2::OvmsServerV2(const char* name)
   MyEvents.RegisterEvent(TAG,"network.reconfigured", std::bind(&OvmsServerV2::NetReconfigured, this, _1, _2));
   MyEvents.RegisterEvent(TAG,"network.mgr.init", std::bind(&OvmsServerV2::NetmanInit, this, _1, _2));
   MyEvents.RegisterEvent(TAG,"network.mgr.stop", std::bind(&OvmsServerV2::NetmanStop, this, _1, _2));
-  MyEvents.RegisterEvent(TAG,"ticker.1", std::bind(&OvmsServerV2::Ticker1, this, _1, _2));
+  MyEvents.RegisterEventId(TAG,"ticker.1", std::bind(&OvmsServerV2::Ticker1, this, _1, _2, _3));
   MyEvents.RegisterEvent(TAG,"system.modem.received.ussd", std::bind(&OvmsServerV2::EventListener, this, _1, _2));
   MyEvents.RegisterEvent(TAG,"config.changed", std::bind(&OvmsServerV2::EventListener, this, _1, _2));
   MyEvents.RegisterEvent(TAG,"config.mounted", std::bind(&OvmsServerV2::EventListener, this, _1, _2));
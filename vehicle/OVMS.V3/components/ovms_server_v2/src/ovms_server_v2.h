@@ -37,6 +37,7 @@
 #include <iomanip>
 #include <sys/time.h>
 #include "ovms_server.h"
+#include "ovms_events.h"
 #include "ovms_netmanager.h"
 #include "ovms_buffer.h"
 #include "crypt_rc4.h"
@@ -93,7 +94,7 @@ class OvmsServerV2 : public OvmsServer
     void NetReconfigured(std::string event, void* data);
     void NetmanInit(std::string event, void* data);
     void NetmanStop(std::string event, void* data);
-    void Ticker1(std::string event, void* data);
+    void Ticker1(event_id_t id, const char* event, void* data);
 
   public:
     enum State
@@ -134,9 +135,14 @@ class OvmsServerV2 : public OvmsServer
 
     bool m_paranoid;
     uint8_t m_pdigest[OVMS_MD5_SIZE];
+    RC4_CTX1 m_pcrypto1;                  // paranoid mode initial cipher state
+    RC4_CTX2 m_pcrypto2;                  // … (cloned for every message)
     std::string m_ptoken;
     bool m_ptoken_ready;
 
+    uint8_t* m_txbuf;                     // transmit encoding buffer
+    size_t m_txbufsize;
+
     bool m_now_stat;
     bool m_now_gps;
     bool m_now_tpms;
@@ -201,6 +201,9 @@ OvmsServerV3::OvmsServerV3(const char* name)
   m_updatetime_on = m_updatetime_idle;
   m_updatetime_charging = m_updatetime_idle;
   m_updatetime_sendall = 0;
+  m_metrics_delta = false;
+  m_metrics_compact = false;
+  m_metric_generation = 0;
   m_notify_info_pending = false;
   m_notify_error_pending = false;
   m_notify_alert_pending = false;
@@ -214,6 +217,7 @@ OvmsServerV3::OvmsServerV3(const char* name)
   #undef bind  // Kludgy, but works
   using std::placeholders::_1;
   using std::placeholders::_2;
+  using std::placeholders::_3;
   MyMetrics.RegisterListener(TAG, "*", std::bind(&OvmsServerV3::MetricModified, this, _1));
 
   if (MyOvmsServerV3Reader == 0)
@@ -233,8 +237,8 @@ OvmsServerV3::OvmsServerV3(const char* name)
   MyEvents.RegisterEvent(TAG,"network.reconfigured", std::bind(&OvmsServerV3::NetReconfigured, this, _1, _2));
   MyEvents.RegisterEvent(TAG,"network.mgr.init", std::bind(&OvmsServerV3::NetmanInit, this, _1, _2));
   MyEvents.RegisterEvent(TAG,"network.mgr.stop", std::bind(&OvmsServerV3::NetmanStop, this, _1, _2));
-  MyEvents.RegisterEvent(TAG,"ticker.1", std::bind(&OvmsServerV3::Ticker1, this, _1, _2));
-  MyEvents.RegisterEvent(TAG,"ticker.60", std::bind(&OvmsServerV3::Ticker60, this, _1, _2));
+  MyEvents.RegisterEventId(TAG,"ticker.1", std::bind(&OvmsServerV3::Ticker1, this, _1, _2, _3));
+  MyEvents.RegisterEventId(TAG,"ticker.60", std::bind(&OvmsServerV3::Ticker60, this, _1, _2, _3));
   MyEvents.RegisterEvent(TAG,"system.modem.received.ussd", std::bind(&OvmsServerV3::EventListener, this, _1, _2));
   MyEvents.RegisterEvent(TAG,"config.changed", std::bind(&OvmsServerV3::EventListener, this, _1, _2));
   MyEvents.RegisterEvent(TAG,"config.mounted", std::bind(&OvmsServerV3::EventListener, this, _1, _2));
@@ -257,16 +261,62 @@ OvmsServerV3::~OvmsServerV3()
   MyEvents.SignalEvent("server.v3.stopped", NULL);
   }
 
+/**
+ * Metric transmission state:
+ *  m_metric_state caches the MQTT topics and vector delta sequences by metric.
+ *  States are discarded if metrics have been removed (the metric address may
+ *  then be reused), and on each new connection (the topic prefix may change).
+ */
+void OvmsServerV3::CheckMetricStates()
+  {
+  uint32_t generation = MyMetrics.m_generation;
+  if (generation != m_metric_generation)
+    {
+    m_metric_state.clear();
+    m_metric_generation = generation;
+    }
+  }
+
+OvmsServerV3MetricState& OvmsServerV3::GetMetricState(OvmsMetric* metric)
+  {
+  auto it = m_metric_state.find(metric);
+  if (it != m_metric_state.end())
+    return it->second;
+  OvmsServerV3MetricState& state = m_metric_state[metric];
+  state.topic = MakeTopic("metric/", metric->m_name);
+  state.deltaseq = 0;
+  return state;
+  }
+
+std::string OvmsServerV3::MakeTopic(const char* type, const char* name)
+  {
+  std::string topic(m_topic_prefix);
+  topic.append(type);
+  topic.append(name);
+
+  // Replace '.' inside the metric name by '/' for MQTT like namespacing.
+  for(size_t i = m_topic_prefix.length(); i < topic.length(); i++)
+    {
+      if(topic[i] == '.')
+        topic[i] = '/';
+    }
+  return topic;
+  }
+
 void OvmsServerV3::TransmitAllMetrics()
   {
   OvmsMutexLock mg(&m_mgconn_mutex);
   if (!m_mgconn)
     return;
 
+  CheckMetricStates();
+  m_metrics_journal.Reset();
   OvmsMetric* metric = MyMetrics.m_first;
   while (metric != NULL)
     {
     metric->ClearModified(MyOvmsServerV3Modifier);
+    if (m_metrics_delta)
+      GetMetricState(metric).deltaseq = metric->GetDeltaSeq();
     if (!metric->AsString().empty())
       {
       TransmitMetric(metric);
@@ -281,35 +331,140 @@ void OvmsServerV3::TransmitModifiedMetrics()
   if (!m_mgconn)
     return;
 
-  OvmsMetric* metric = MyMetrics.m_first;
-  while (metric != NULL)
+  if (m_metrics_compact)
+    {
+    TransmitCompactMetrics();
+    return;
+    }
+
+  // Note: the modifier flag is still checked here, as metrics may already
+  //  have been transmitted by streaming (see MetricModified())
+  CheckMetricStates();
+  OvmsServerV3TxBatch batch;
+  OvmsMetric* metric;
+  while ((metric = m_metrics_journal.Next()) != NULL)
     {
     if (metric->IsModifiedAndClear(MyOvmsServerV3Modifier))
       {
-      TransmitMetric(metric);
+      AddMetricUpdate(batch, metric);
       }
-    metric = metric->m_next;
     }
+  TransmitBatch(batch);
   }
 
-void OvmsServerV3::TransmitMetric(OvmsMetric* metric)
+/**
+ * TransmitCompactMetrics: transmit all changed metrics as one JSON document
+ *  (config server.v3 metrics.compact) to <prefix>metrics (not retained), using
+ *  the web UI format: {"metrics":{"<name>":<value>,…},"mdelta":{"<name>":[…],…}}
+ *  The "mdelta" part is only present with vector deltas enabled (see below).
+ *  The retained metric topics are only updated by a full transmission.
+ */
+void OvmsServerV3::TransmitCompactMetrics()
   {
-  std::string topic(m_topic_prefix);
-  topic.append("metric/");
-  topic.append(metric->m_name);
+  CheckMetricStates();
+  int cnt = 0, dcnt = 0;
+  std::string doc, delta, json;
+  doc.reserve(1024);
+  doc = "{\"metrics\":{";
+  OvmsMetric* metric;
+  while ((metric = m_metrics_journal.Next()) != NULL)
+    {
+    if (!metric->IsModifiedAndClear(MyOvmsServerV3Modifier))
+      continue;
+    if (m_metrics_delta && metric->GetDeltaSeq() &&
+        metric->AsDeltaJSON(json, GetMetricState(metric).deltaseq))
+      {
+      if (json.empty()) continue;
+      delta += dcnt++ ? ",\"" : ",\"mdelta\":{\"";
+      delta += metric->m_name;
+      delta += "\":";
+      delta += json;
+      continue;
+      }
+    if (cnt++) doc += ',';
+    doc += '\"';
+    doc += metric->m_name;
+    doc += "\":";
+    doc += metric->AsJSON();
+    }
+  if (cnt + dcnt == 0)
+    return;
+  doc += '}';
+  if (dcnt)
+    {
+    doc += delta;
+    doc += '}';
+    }
+  doc += '}';
 
-  // Replace '.' inside the metric name by '/' for MQTT like namespacing.
-  for(size_t i = m_topic_prefix.length(); i < topic.length(); i++)
+  mg_mqtt_publish(m_mgconn, m_compact_topic.c_str(), m_msgid++,
+    MG_MQTT_QOS(0), doc.c_str(), doc.length());
+  ESP_LOGI(TAG,"Tx %d metrics, %d deltas (%u bytes)", cnt, dcnt, (unsigned)doc.length());
+  ESP_LOGD(TAG,"Tx %s=%s",m_compact_topic.c_str(),doc.c_str());
+  }
+
+/**
+ * AddMetricUpdate: add a changed metric to a transmission batch
+ *  If enabled (config server.v3 metrics.delta), vector metrics are sent as
+ *  element deltas to <prefix>delta/<metric> (not retained), the payload being
+ *  a JSON array of the vector size followed by the index/value pairs changed,
+ *  e.g. [96,3,4.012,17,4.009]. The retained full value is then only updated
+ *  by a full transmission (on login and by the sendall interval).
+ */
+void OvmsServerV3::AddMetricUpdate(OvmsServerV3TxBatch& batch, OvmsMetric* metric)
+  {
+  OvmsServerV3MetricState& state = GetMetricState(metric);
+  if (m_metrics_delta && metric->GetDeltaSeq())
     {
-      if(topic[i] == '.')
-        topic[i] = '/';
+    std::string val;
+    if (metric->AsDeltaJSON(val, state.deltaseq))
+      {
+      if (val.empty())
+        return;
+      if (state.deltatopic.empty())
+        state.deltatopic = MakeTopic("delta/", metric->m_name);
+      batch.push_back({ &state.deltatopic, val, false });
+      return;
+      }
+    }
+  batch.push_back({ &state.topic, metric->AsString(), true });
+  }
+
+/**
+ * TransmitBatch: publish a batch of messages
+ *  The connection send buffer is extended once for the whole batch, so the
+ *  messages are collected without reallocations and sent with the next
+ *  network poll in one go.
+ */
+void OvmsServerV3::TransmitBatch(OvmsServerV3TxBatch& batch)
+  {
+  if (batch.empty())
+    return;
+
+  size_t size = 0;
+  for (auto& tx : batch)
+    size += tx.topic->length() + tx.payload.length() + 8;  // + MQTT header
+  struct mbuf* mb = &m_mgconn->send_mbuf;
+  if (mb->size < mb->len + size)
+    mbuf_resize(mb, mb->len + size);
+
+  for (auto& tx : batch)
+    {
+    mg_mqtt_publish(m_mgconn, tx.topic->c_str(), m_msgid++,
+      MG_MQTT_QOS(0) | (tx.retain ? MG_MQTT_RETAIN : 0), tx.payload.c_str(), tx.payload.length());
+    ESP_LOGD(TAG,"Tx %s=%s",tx.topic->c_str(),tx.payload.c_str());
     }
+  ESP_LOGI(TAG,"Tx %u metrics (%u bytes)", (unsigned)batch.size(), (unsigned)size);
+  }
 
+void OvmsServerV3::TransmitMetric(OvmsMetric* metric)
+  {
+  const std::string& topic = GetMetricState(metric).topic;
   std::string val = metric->AsString();
 
   mg_mqtt_publish(m_mgconn, topic.c_str(), m_msgid++,
     MG_MQTT_QOS(0) | MG_MQTT_RETAIN, val.c_str(), val.length());
-  ESP_LOGI(TAG,"Tx metric %s=%s",topic.c_str(),val.c_str());
+  ESP_LOGD(TAG,"Tx metric %s=%s",topic.c_str(),val.c_str());
   }
 
 int OvmsServerV3::TransmitNotificationInfo(OvmsNotifyEntry* entry)
@@ -648,6 +803,9 @@ void OvmsServerV3::Connect()
   m_conn_topic[1] = std::string(m_topic_prefix);
   m_conn_topic[1].append("client/+/command/+");
 
+  m_compact_topic = std::string(m_topic_prefix);
+  m_compact_topic.append("metrics");
+
   if (m_port.empty())
     {
     m_port = (m_tls)?"8883":"1883";
@@ -671,6 +829,7 @@ void OvmsServerV3::Connect()
 
   SetStatus("Connecting...", false, Connecting);
   OvmsMutexLock mg(&m_mgconn_mutex);
+  m_metric_state.clear();
   struct mg_mgr* mgr = MyNetManager.GetMongooseMgr();
   struct mg_connect_opts opts;
   const char* err;
@@ -753,7 +912,10 @@ void OvmsServerV3::MetricModified(OvmsMetric* metric)
     if (!m_mgconn)
       return;
     metric->ClearModified(MyOvmsServerV3Modifier);
-    TransmitMetric(metric);
+    CheckMetricStates();
+    OvmsServerV3TxBatch batch;
+    AddMetricUpdate(batch, metric);
+    TransmitBatch(batch);
     }
   }
 
@@ -823,6 +985,8 @@ void OvmsServerV3::ConfigChanged(OvmsConfigParam* param)
   m_updatetime_on = MyConfig.GetParamValueInt("server.v3", "updatetime.on", m_updatetime_idle);
   m_updatetime_charging = MyConfig.GetParamValueInt("server.v3", "updatetime.charging", m_updatetime_idle);
   m_updatetime_sendall = MyConfig.GetParamValueInt("server.v3", "updatetime.sendall", 0);
+  m_metrics_delta = MyConfig.GetParamValueBool("server.v3", "metrics.delta", false);
+  m_metrics_compact = MyConfig.GetParamValueBool("server.v3", "metrics.compact", false);
   }
 
 void OvmsServerV3::NetUp(std::string event, void* data)
@@ -869,7 +1033,7 @@ void OvmsServerV3::NetmanStop(std::string event, void* data)
     }
   }
 
-void OvmsServerV3::Ticker1(std::string event, void* data)
+void OvmsServerV3::Ticker1(event_id_t id, const char* event, void* data)
   {
   if (m_connretry > 0)
     {
@@ -938,7 +1102,7 @@ void OvmsServerV3::Ticker1(std::string event, void* data)
     }
   }
 
-void OvmsServerV3::Ticker60(std::string event, void* data)
+void OvmsServerV3::Ticker60(event_id_t id, const char* event, void* data)
   {
   CountClients();
   }
@@ -1031,7 +1195,8 @@ OvmsServerV3Init::OvmsServerV3Init()
 
   using std::placeholders::_1;
   using std::placeholders::_2;
-  MyEvents.RegisterEvent(TAG, "*", std::bind(&OvmsServerV3Init::EventListener, this, _1, _2));
+  using std::placeholders::_3;
+  MyEvents.RegisterEventId(TAG, "*", std::bind(&OvmsServerV3Init::EventListener, this, _1, _2, _3));
 
   MyConfig.RegisterParam("server.v3", "V3 Server Configuration", true, true);
   // Our instances:
@@ -1049,11 +1214,11 @@ void OvmsServerV3Init::AutoInit()
     MyOvmsServerV3 = new OvmsServerV3("oscv3");
   }
 
-void OvmsServerV3Init::EventListener(std::string event, void* data)
+void OvmsServerV3Init::EventListener(event_id_t id, const char* event, void* data)
   {
-  if (event.compare(0,7,"ticker.") == 0) return; // Skip ticker.* events
-  if (event.compare("system.event") == 0) return; // Skip event
-  if (event.compare("system.wifi.scan.done") == 0) return; // Skip event
+  if (strncmp(event, "ticker.", 7) == 0) return; // Skip ticker.* events
+  if (strcmp(event, "system.event") == 0) return; // Skip event
+  if (strcmp(event, "system.wifi.scan.done") == 0) return; // Skip event
 
   if (MyOvmsServerV3)
     {
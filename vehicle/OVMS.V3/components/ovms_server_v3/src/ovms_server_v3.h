@@ -33,7 +33,9 @@
 
 #include <string>
 #include <map>
+#include <vector>
 #include "ovms_server.h"
+#include "ovms_events.h"
 #include "ovms_netmanager.h"
 #include "ovms_metrics.h"
 #include "ovms_notify.h"
@@ -42,6 +44,22 @@
 
 typedef std::map<std::string, uint32_t> OvmsServerV3ClientMap;
 
+struct OvmsServerV3MetricState
+  {
+  std::string topic;                      // cached "<prefix>metric/<name>" topic
+  std::string deltatopic;                 // cached "<prefix>delta/<name>" topic (on first use)
+  uint32_t deltaseq;                      // last vector change sequence sent
+  };
+typedef std::map<OvmsMetric*, OvmsServerV3MetricState> OvmsServerV3MetricMap;
+
+struct OvmsServerV3TxEntry
+  {
+  const std::string* topic;
+  std::string payload;
+  bool retain;
+  };
+typedef std::vector<OvmsServerV3TxEntry> OvmsServerV3TxBatch;
+
 #define MQTT_CONN_NTOPICS 2
 
 class OvmsServerV3 : public OvmsServer
@@ -61,8 +79,8 @@ class OvmsServerV3 : public OvmsServer
     void NetReconfigured(std::string event, void* data);
     void NetmanInit(std::string event, void* data);
     void NetmanStop(std::string event, void* data);
-    void Ticker1(std::string event, void* data);
-    void Ticker60(std::string event, void* data);
+    void Ticker1(event_id_t id, const char* event, void* data);
+    void Ticker60(event_id_t id, const char* event, void* data);
 
   public:
     enum State
@@ -106,6 +124,9 @@ class OvmsServerV3 : public OvmsServer
     int m_updatetime_on;
     int m_updatetime_charging;
     int m_updatetime_sendall;
+    bool m_metrics_delta;
+    bool m_metrics_compact;
+    std::string m_compact_topic;
 
     bool m_notify_info_pending;
     bool m_notify_error_pending;
@@ -115,6 +136,9 @@ class OvmsServerV3 : public OvmsServer
     OvmsNotifyType* m_notify_data_waittype;
     OvmsNotifyEntry* m_notify_data_waitentry;
     OvmsServerV3ClientMap m_clients;
+    OvmsMetricJournalReader m_metrics_journal;
+    OvmsServerV3MetricMap m_metric_state;
+    uint32_t m_metric_generation;
 
   public:
     virtual void SetPowerMode(PowerMode powermode);
@@ -139,7 +163,13 @@ class OvmsServerV3 : public OvmsServer
     void CountClients();
 
   private:
+    void CheckMetricStates();
+    OvmsServerV3MetricState& GetMetricState(OvmsMetric* metric);
+    std::string MakeTopic(const char* type, const char* name);
     void TransmitMetric(OvmsMetric* metric);
+    void AddMetricUpdate(OvmsServerV3TxBatch& batch, OvmsMetric* metric);
+    void TransmitBatch(OvmsServerV3TxBatch& batch);
+    void TransmitCompactMetrics();
   };
 
 class OvmsServerV3Init
@@ -149,7 +179,7 @@ class OvmsServerV3Init
     void AutoInit();
 
   public:
-    void EventListener(std::string event, void* data);
+    void EventListener(event_id_t id, const char* event, void* data);
   };
 
 extern OvmsServerV3Init MyOvmsServerV3Init;
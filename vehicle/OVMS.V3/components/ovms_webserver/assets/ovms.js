@@ -369,7 +369,24 @@ function initSocketConnection(){
       }
       else if (msgtype == "metrics") {
         $.extend(metrics, msg.metrics);
-        $(".receiver").trigger("msg:metrics", msg.metrics);
+        if (!msg.mdelta)
+          $(".receiver").trigger("msg:metrics", msg.metrics);
+      }
+      else if (msgtype == "mdelta") {
+        // vector metric deltas: [size, index, value, index, value, …]
+        // apply to copies of the known vectors, pass changed indexes as second argument:
+        var update = $.extend({}, msg.metrics), delta = {};
+        for (var name in msg.mdelta) {
+          var md = msg.mdelta[name], val = $.isArray(metrics[name]) ? metrics[name].slice() : [], idx = [];
+          val.length = md[0];
+          for (var i = 1; i < md.length; i += 2) {
+            val[md[i]] = md[i+1];
+            idx.push(md[i]);
+          }
+          metrics[name] = update[name] = val;
+          delta[name] = idx;
+        }
+        $(".receiver").trigger("msg:metrics", [update, delta]);
       }
       else if (msgtype == "notify") {
         processNotification(msg.notify);
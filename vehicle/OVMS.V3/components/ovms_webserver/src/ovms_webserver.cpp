@@ -74,11 +74,12 @@ OvmsWebServer::OvmsWebServer()
   #undef bind  // Kludgy, but works
   using std::placeholders::_1;
   using std::placeholders::_2;
+  using std::placeholders::_3;
   MyEvents.RegisterEvent(TAG, "network.mgr.init", std::bind(&OvmsWebServer::NetManInit, this, _1, _2));
   MyEvents.RegisterEvent(TAG, "network.mgr.stop", std::bind(&OvmsWebServer::NetManStop, this, _1, _2));
   MyEvents.RegisterEvent(TAG, "config.changed", std::bind(&OvmsWebServer::ConfigChanged, this, _1, _2));
   MyEvents.RegisterEvent(TAG, "config.mounted", std::bind(&OvmsWebServer::ConfigChanged, this, _1, _2));
-  MyEvents.RegisterEvent(TAG, "*", std::bind(&OvmsWebServer::EventListener, this, _1, _2));
+  MyEvents.RegisterEventId(TAG, "*", std::bind(&OvmsWebServer::EventListener, this, _1, _2, _3));
 
   // register standard framework URIs:
   RegisterPage("/", "OVMS", HandleRoot);
@@ -199,9 +200,12 @@ void OvmsWebServer::ConfigChanged(std::string event, void* data)
     //    auth.domain         ovms                    Default auth domain (digest realm)
     //    auth.file           .htpasswd               Per directory auth file (Note: no inheritance from parent dir!)
     //    auth.global         yes                     Use global auth for files (user "admin", module password)
+    //    cache.maxage        0                       File cache lifetime [s] (0 = revalidate on each use)
 
     if (m_file_opts.document_root)
       free((void*)m_file_opts.document_root);
+    if (m_file_opts.extra_headers)
+      free((void*)m_file_opts.extra_headers);
     if (m_file_opts.auth_domain)
       free((void*)m_file_opts.auth_domain);
     if (m_file_opts.per_directory_auth_file)
@@ -220,6 +224,15 @@ void OvmsWebServer::ConfigChanged(std::string event, void* data)
       strdup(MyConfig.GetParamValue("http.server", "auth.file", ".htpasswd").c_str());
     m_file_opts.global_auth_file =
       MyConfig.GetParamValueBool("http.server", "auth.global", true) ? OVMS_GLOBAL_AUTH_FILE : NULL;
+
+    // Note: mongoose handles conditional requests (Etag / Last-Modified) for files
+    char cache_control[50];
+    int maxage = MyConfig.GetParamValueInt("http.server", "cache.maxage", 0);
+    if (maxage > 0)
+      snprintf(cache_control, sizeof(cache_control), "Cache-Control: max-age=%d", maxage);
+    else
+      strcpy(cache_control, "Cache-Control: no-cache");
+    m_file_opts.extra_headers = strdup(cache_control);
   }
 
   if (!param || param->GetName() == "password") {
@@ -372,6 +385,14 @@ void PagePluginContent::LoadContent()
       ESP_LOGD(TAG, "Plugin file loaded: '%s', %u bytes", path.c_str(), (size_t)size);
     }
   }
+
+  // Etag for conditional requests: FNV-1a hash of the content
+  uint32_t hash = 2166136261u;
+  for (char ch : m_content)
+    hash = (hash ^ (uint8_t)ch) * 16777619u;
+  char etag[30];
+  snprintf(etag, sizeof(etag), "\"p%08x.%u\"", (unsigned) hash, (unsigned) m_content.size());
+  m_etag = etag;
 }
 
 void OvmsWebServer::RegisterPlugins()
@@ -450,7 +471,13 @@ void OvmsWebServer::PluginHandler(PageEntry_t& p, PageContext_t& c)
     return;
 
   extram::string& content = i->second.GetContent();
-  c.head(200);
+  std::string headers =
+    "Content-Type: text/html; charset=utf-8\r\n"
+    "Cache-Control: no-cache\r\n"
+    "Etag: " + i->second.m_etag;
+  if (c.not_modified(i->second.m_etag.c_str(), NULL, headers.c_str()))
+    return;
+  c.head(200, headers.c_str());
   c.print(content);
   c.done();
 }
@@ -147,6 +147,7 @@ struct PageContext : public ExternalRamAllocated
   // output:
   void error(int code, const char* text);
   void head(int code, const char* headers=NULL);
+  bool not_modified(const char* etag, const char* last_modified=NULL, const char* headers=NULL);
   void print(const std::string text);
   void print(const extram::string text);
   void print(const char* text);
@@ -245,6 +246,7 @@ struct PagePluginContent
 {
   std::string       m_path;
   extram::string    m_content;
+  std::string       m_etag;
 
   PagePluginContent(std::string path) {
     m_path = path;
@@ -385,7 +387,7 @@ struct WebSocketTxTodo
 class WebSocketHandler : public MgHandler, public OvmsWriter
 {
   public:
-    WebSocketHandler(mg_connection* nc, size_t slot, size_t modifier, size_t reader);
+    WebSocketHandler(mg_connection* nc, size_t slot, size_t reader);
     ~WebSocketHandler();
 
   public:
@@ -411,7 +413,12 @@ class WebSocketHandler : public MgHandler, public OvmsWriter
 
   public:
     size_t                    m_slot = 0;
-    size_t                    m_modifier = 0;         // "our" metrics modifier
+    OvmsMetricCursor          m_metrics_cursor;       // MetricsAll job position
+    OvmsMetricJournalReader   m_metrics_journal;      // "our" metrics change reader
+    std::string               m_msgbuf;               // metrics message buffer
+    std::string               m_deltabuf;             // … vector metrics delta part
+    std::map<OvmsMetric*, uint32_t> m_metrics_delta;  // vector metrics change sequences sent
+    uint32_t                  m_metrics_generation = 0; // MyMetrics generation m_metrics_delta is valid for
     size_t                    m_reader = 0;           // "our" notification reader id
     QueueHandle_t             m_jobqueue = NULL;
     uint32_t                  m_jobqueue_overflow_status = 0;
@@ -427,7 +434,6 @@ class WebSocketHandler : public MgHandler, public OvmsWriter
 struct WebSocketSlot
 {
   WebSocketHandler*   handler;
-  size_t              modifier;
   size_t              reader;
 };
 
@@ -489,7 +495,7 @@ class OvmsWebServer : public ExternalRamAllocated
     void UpdateGlobalAuthFile();
     static const std::string MakeDigestAuth(const char* realm, const char* username, const char* password);
     static const std::string ExecuteCommand(const std::string command, int verbosity=COMMAND_RESULT_NORMAL);
-    void EventListener(std::string event, void* data);
+    void EventListener(event_id_t id, const char* event, void* data);
     static void UpdateTicker(TimerHandle_t timer);
     static bool NotificationFilter(int client, OvmsNotifyType* type, const char* subtype);
     static bool IncomingNotification(int client, OvmsNotifyType* type, OvmsNotifyEntry* entry);
@@ -57,13 +57,12 @@ static const char *TAG = "websocket";
  * successive sends, the UpdateTicker sends collected intermediate updates.
  */
 
-WebSocketHandler::WebSocketHandler(mg_connection* nc, size_t slot, size_t modifier, size_t reader)
+WebSocketHandler::WebSocketHandler(mg_connection* nc, size_t slot, size_t reader)
   : MgHandler(nc)
 {
-  ESP_LOGV(TAG, "WebSocketHandler[%p] init: handler=%p modifier=%d", nc, this, modifier);
+  ESP_LOGV(TAG, "WebSocketHandler[%p] init: handler=%p", nc, this);
   
   m_slot = slot;
-  m_modifier = modifier;
   m_reader = reader;
   m_jobqueue = xQueueCreate(50, sizeof(WebSocketTxJob));
   m_jobqueue_overflow_status = 0;
@@ -72,6 +71,8 @@ WebSocketHandler::WebSocketHandler(mg_connection* nc, size_t slot, size_t modifi
   m_jobqueue_overflow_dropcntref = 0;
   m_job.type = WSTX_None;
   m_sent = m_ack = 0;
+  m_msgbuf.reserve(2*XFER_CHUNK_SIZE+128);
+  m_deltabuf.reserve(XFER_CHUNK_SIZE+128);
   
   // Register as logging console:
   SetMonitoring(true);
@@ -116,37 +117,70 @@ void WebSocketHandler::ProcessTxJob()
     case WSTX_MetricsAll:
     case WSTX_MetricsUpdate:
     {
-      // Note: this loops over the metrics by index, keeping the checked count
-      //  in m_sent. It will not detect new metrics added between polls if they are
-      //  inserted before m_sent, so new metrics may not be sent until first changed.
-      //  The Metrics set normally is static, so this should be no problem.
+      // Note: MetricsAll walks the metrics list using our cursor, MetricsUpdate
+      //  reads the changed metrics from the metrics change journal. Both keep
+      //  their position between the chunks.
+      //  The cursor will not detect new metrics added before its position, so
+      //  new metrics may not be sent until first changed. The Metrics set normally
+      //  is static, so this should be no problem.
       
-      // find start:
-      int i;
-      OvmsMetric* m;
-      for (i=0, m=MyMetrics.m_first; i < m_sent && m != NULL; m=m->m_next, i++);
+      //  Vector metrics already known by the client are sent as element deltas
+      //  (see OvmsMetricVector::AsDeltaJSON()) in the "mdelta" part of the message.
+      
+      // discard delta states if metrics have been removed (addresses may be reused),
+      //  the client then gets the full values:
+      uint32_t generation = MyMetrics.m_generation;
+      if (generation != m_metrics_generation) {
+        m_metrics_delta.clear();
+        m_metrics_generation = generation;
+      }
       
       // build msg:
-      std::string msg;
-      msg.reserve(2*XFER_CHUNK_SIZE+128);
+      int i = 0, d = 0;
+      OvmsMetric* m = NULL;
+      std::string& msg = m_msgbuf;
+      std::string& delta = m_deltabuf;
+      std::string json;
       msg = "{\"metrics\":{";
-      for (i=0; m && msg.size() < XFER_CHUNK_SIZE; m=m->m_next) {
-        if (m->IsModifiedAndClear(m_modifier) || m_job.type == WSTX_MetricsAll) {
-          if (i) msg += ',';
-          msg += '\"';
-          msg += m->m_name;
-          msg += "\":";
-          msg += m->AsJSON();
-          i++;
+      delta.clear();
+      while (msg.size() + delta.size() < XFER_CHUNK_SIZE) {
+        m = (m_job.type == WSTX_MetricsAll) ? m_metrics_cursor.Next() : m_metrics_journal.Next();
+        if (!m) break;
+        uint32_t dseq = m->GetDeltaSeq();
+        if (dseq) {
+          uint32_t& seq = m_metrics_delta[m];
+          if (m_job.type == WSTX_MetricsAll) {
+            seq = dseq;
+          }
+          else if (m->AsDeltaJSON(json, seq)) {
+            if (json.empty()) continue;
+            delta += d ? ",\"" : ",\"mdelta\":{\"";
+            delta += m->m_name;
+            delta += "\":";
+            delta += json;
+            d++;
+            continue;
+          }
         }
+        if (i) msg += ',';
+        msg += '\"';
+        msg += m->m_name;
+        msg += "\":";
+        msg += m->AsJSON();
+        i++;
       }
       
       // send msg:
-      if (i) {
-        msg += "}}";
+      if (i || d) {
+        msg += '}';
+        if (d) {
+          msg += delta;
+          msg += '}';
+        }
+        msg += '}';
         ESP_EARLY_LOGV(TAG, "WebSocket msg: %s", msg.c_str());
         mg_send_websocket_frame(m_nc, WEBSOCKET_OP_TEXT, msg.data(), msg.size());
-        m_sent += i;
+        m_sent += i + d;
       }
       
       // done?
@@ -301,6 +335,7 @@ bool WebSocketHandler::GetNextTxJob()
   if (xQueueReceive(m_jobqueue, &m_job, 0) == pdTRUE) {
     // init new job state:
     m_sent = m_ack = 0;
+    m_metrics_cursor.Reset();
     return true;
   } else {
     return false;
@@ -423,7 +458,7 @@ void WebSocketHandler::Log(LogBuffers* message)
 
 /**
  * WebSocketHandler slot registry:
- *  WebSocketSlots keep metrics modifiers once allocated (limited ressource)
+ *  WebSocketSlots keep notification readers once allocated
  */
 
 WebSocketHandler* OvmsWebServer::CreateWebSocketHandler(mg_connection* nc)
@@ -443,11 +478,10 @@ WebSocketHandler* OvmsWebServer::CreateWebSocketHandler(mg_connection* nc)
     // create new client slot:
     WebSocketSlot slot;
     slot.handler = NULL;
-    slot.modifier = MyMetrics.RegisterModifier();
     slot.reader = MyNotify.RegisterReader("ovmsweb", COMMAND_RESULT_VERBOSE,
                                           std::bind(&OvmsWebServer::IncomingNotification, i, _1, _2), true,
                                           std::bind(&OvmsWebServer::NotificationFilter, i, _1, _2));
-    ESP_LOGD(TAG, "new WebSocket slot %d, registered modifier is %d, reader %d", i, slot.modifier, slot.reader);
+    ESP_LOGD(TAG, "new WebSocket slot %d, registered reader %d", i, slot.reader);
     m_client_slots.push_back(slot);
   } else {
     // reuse slot:
@@ -457,7 +491,7 @@ WebSocketHandler* OvmsWebServer::CreateWebSocketHandler(mg_connection* nc)
   }
   
   // create handler:
-  WebSocketHandler* handler = new WebSocketHandler(nc, i, m_client_slots[i].modifier, m_client_slots[i].reader);
+  WebSocketHandler* handler = new WebSocketHandler(nc, i, m_client_slots[i].reader);
   m_client_slots[i].handler = handler;
   
   // start ticker:
@@ -519,23 +553,23 @@ bool OvmsWebServer::AddToBacklog(int client, WebSocketTxJob job)
 /**
  * EventListener:
  */
-void OvmsWebServer::EventListener(std::string event, void* data)
+void OvmsWebServer::EventListener(event_id_t id, const char* event, void* data)
 {
   // shutdown delay to finish command output transmissions:
-  if (event == "system.shuttingdown") {
+  if (strcmp(event, "system.shuttingdown") == 0) {
     MyBoot.RestartPending("webserver");
     m_restart_countdown = 3;
   }
 
   // ticker:
-  else if (event == "ticker.1") {
+  else if (strcmp(event, "ticker.1") == 0) {
     CfgInitTicker();
     if (m_restart_countdown > 0 && --m_restart_countdown == 0)
       MyBoot.RestartReady("webserver");
   }
 
   // reload plugins on changes:
-  else if (event == "system.vfs.file.changed") {
+  else if (strcmp(event, "system.vfs.file.changed") == 0) {
     char* path = (char*)data;
     if (strncmp(path, "/store/plugin/", 14) == 0)
       ReloadPlugin(path);
@@ -547,9 +581,9 @@ void OvmsWebServer::EventListener(std::string event, void* data)
     for (int i=0; i<m_client_cnt; i++) {
       auto& slot = m_client_slots[i];
       if (slot.handler) {
-        WebSocketTxJob job = { WSTX_Event, strdup(event.c_str()) };
+        WebSocketTxJob job = { WSTX_Event, strdup(event) };
         if (!AddToBacklog(i, job)) {
-          ESP_LOGW(TAG, "EventListener: event '%s' dropped for client %d", event.c_str(), i);
+          ESP_LOGW(TAG, "EventListener: event '%s' dropped for client %d", event, i);
           free(job.event);
         }
       }
@@ -560,7 +594,7 @@ void OvmsWebServer::EventListener(std::string event, void* data)
   // client list locked; add tx jobs:
   for (auto slot: m_client_slots) {
     if (slot.handler) {
-      WebSocketTxJob job = { WSTX_Event, strdup(event.c_str()) };
+      WebSocketTxJob job = { WSTX_Event, strdup(event) };
       if (!slot.handler->AddTxJob(job, false))
         free(job.event);
       // Note: init_tx false to prevent mg_broadcast() deadlock on network events
@@ -703,12 +737,18 @@ bool OvmsWebServer::IncomingNotification(int client, OvmsNotifyType* type, OvmsN
                type->m_name, entry->GetSubType(), client);
       done = true;
     }
+    else {
+      // keep entry in the notify queue until the job is done:
+      entry->Hold(MyWebServer.m_client_slots[client].reader);
+    }
     return done;
   }
 
   const auto& slot = MyWebServer.m_client_slots[client];
   if (!slot.handler || !slot.handler->AddTxJob(job, false))
     done = true;
+  else
+    entry->Hold(slot.reader);
 
   xSemaphoreGive(MyWebServer.m_client_mutex);
   return done;
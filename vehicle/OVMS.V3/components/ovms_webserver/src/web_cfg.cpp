@@ -504,7 +504,8 @@ void OvmsWebServer::HandleCfgPassword(PageEntry_t& p, PageContext_t& c)
       error += "<li data-input=\"newpass2\">Passwords do not match</li>";
 
     if (error == "") {
-      // success:
+      // success, write & signal config changes once:
+      OvmsConfigTransaction txn;
       if (MyConfig.GetParamValue("password", "module") == MyConfig.GetParamValue("wifi.ap", "OVMS")) {
         MyConfig.SetParamValue("wifi.ap", "OVMS", newpass1);
         info += "<li>New Wifi AP password for network <code>OVMS</code> has been set.</li>";
@@ -605,7 +606,8 @@ void OvmsWebServer::HandleCfgVehicle(PageEntry_t& p, PageContext_t& c)
     }
 
     if (error == "") {
-      // success:
+      // success, write & signal config changes once:
+      OvmsConfigTransaction txn;
       MyConfig.SetParamValue("vehicle", "id", vehicleid);
       MyConfig.SetParamValue("auto", "vehicle.type", vehicletype);
       MyConfig.SetParamValue("vehicle", "name", vehiclename);
@@ -786,6 +788,8 @@ void OvmsWebServer::HandleCfgModem(PageEntry_t& p, PageContext_t& c)
     enable_gps = (c.getvar("enable_gps") == "yes");
     enable_gpstime = (c.getvar("enable_gpstime") == "yes");
 
+    // store, write & signal config changes once:
+    OvmsConfigTransaction txn;
     MyConfig.SetParamValue("modem", "apn", apn);
     MyConfig.SetParamValue("modem", "apn.user", apn_user);
     MyConfig.SetParamValue("modem", "apn.password", apn_pass);
@@ -1345,7 +1349,8 @@ void OvmsWebServer::HandleCfgServerV2(PageEntry_t& p, PageContext_t& c)
     }
 
     if (error == "") {
-      // success:
+      // success, write & signal config changes once:
+      OvmsConfigTransaction txn;
       MyConfig.SetParamValue("server.v2", "server", server);
       MyConfig.SetParamValueBool("server.v2", "tls", tls);
       MyConfig.SetParamValue("server.v2", "port", port);
@@ -1426,7 +1431,7 @@ void OvmsWebServer::HandleCfgServerV3(PageEntry_t& p, PageContext_t& c)
   std::string error;
   std::string server, user, password, port, topic_prefix;
   std::string updatetime_connected, updatetime_idle, updatetime_on, updatetime_charging, updatetime_awake, updatetime_sendall;
-  bool tls;
+  bool tls, metrics_delta, metrics_compact;
 
   if (c.method == "POST") {
     // process form submission:
@@ -1442,6 +1447,8 @@ void OvmsWebServer::HandleCfgServerV3(PageEntry_t& p, PageContext_t& c)
     updatetime_charging = c.getvar("updatetime_charging");
     updatetime_awake = c.getvar("updatetime_awake");
     updatetime_sendall = c.getvar("updatetime_sendall");
+    metrics_delta = (c.getvar("metrics_delta") == "yes");
+    metrics_compact = (c.getvar("metrics_compact") == "yes");
 
     // validate:
     if (port != "") {
@@ -1482,7 +1489,8 @@ void OvmsWebServer::HandleCfgServerV3(PageEntry_t& p, PageContext_t& c)
     }
 
     if (error == "") {
-      // success:
+      // success, write & signal config changes once:
+      OvmsConfigTransaction txn;
       MyConfig.SetParamValue("server.v3", "server", server);
       MyConfig.SetParamValueBool("server.v3", "tls", tls);
       MyConfig.SetParamValue("server.v3", "user", user);
@@ -1508,6 +1516,8 @@ void OvmsWebServer::HandleCfgServerV3(PageEntry_t& p, PageContext_t& c)
         MyConfig.DeleteInstance("server.v3", "updatetime.sendall");
       else
         MyConfig.SetParamValue("server.v3", "updatetime.sendall", updatetime_sendall);
+      MyConfig.SetParamValueBool("server.v3", "metrics.delta", metrics_delta);
+      MyConfig.SetParamValueBool("server.v3", "metrics.compact", metrics_compact);
 
       c.head(200);
       c.alert("success", "<p class=\"lead\">Server V3 (MQTT) connection configured.</p>");
@@ -1535,6 +1545,8 @@ void OvmsWebServer::HandleCfgServerV3(PageEntry_t& p, PageContext_t& c)
     updatetime_charging = MyConfig.GetParamValue("server.v3", "updatetime.charging");
     updatetime_awake = MyConfig.GetParamValue("server.v3", "updatetime.awake");
     updatetime_sendall = MyConfig.GetParamValue("server.v3", "updatetime.sendall");
+    metrics_delta = MyConfig.GetParamValueBool("server.v3", "metrics.delta", false);
+    metrics_compact = MyConfig.GetParamValueBool("server.v3", "metrics.compact", false);
 
     // generate form:
     c.head(200);
@@ -1572,6 +1584,13 @@ void OvmsWebServer::HandleCfgServerV3(PageEntry_t& p, PageContext_t& c)
     "optional, in seconds, only used if set");
   c.input_text("…sendall", "updatetime_sendall", updatetime_sendall.c_str(),
     "optional, in seconds, only used if set");
+  c.input_checkbox("Send vector deltas", "metrics_delta", metrics_delta,
+    "<p>Send changed elements of vector metrics (e.g. cell voltages) as index/value pairs to "
+    "<code>…/delta/…</code> instead of the full retained value. Set a <i>sendall</i> interval "
+    "to refresh the retained values regularly.</p>");
+  c.input_checkbox("Compact metrics updates", "metrics_compact", metrics_compact,
+    "<p>Send all changed metrics of an update as one JSON object to <code>…/metrics</code> "
+    "instead of one message per metric. Retained values are only updated by <i>sendall</i>.</p>");
   c.fieldset_end();
 
   c.hr();
@@ -1615,7 +1634,8 @@ void OvmsWebServer::HandleCfgNotifications(PageEntry_t& p, PageContext_t& c)
     }
 
     if (error == "") {
-      // success:
+      // success, write & signal config changes once:
+      OvmsConfigTransaction txn;
       if (log_trip_storetime == "")
         MyConfig.DeleteInstance("notify", "log.trip.storetime");
       else
@@ -1700,7 +1720,7 @@ void OvmsWebServer::HandleCfgNotifications(PageEntry_t& p, PageContext_t& c)
 void OvmsWebServer::HandleCfgWebServer(PageEntry_t& p, PageContext_t& c)
 {
   std::string error, warn;
-  std::string docroot, auth_domain, auth_file;
+  std::string docroot, auth_domain, auth_file, cache_maxage;
   bool enable_files, enable_dirlist, auth_global;
 
   if (c.method == "POST") {
@@ -1711,6 +1731,7 @@ void OvmsWebServer::HandleCfgWebServer(PageEntry_t& p, PageContext_t& c)
     enable_files = (c.getvar("enable_files") == "yes");
     enable_dirlist = (c.getvar("enable_dirlist") == "yes");
     auth_global = (c.getvar("auth_global") == "yes");
+    cache_maxage = c.getvar("cache_maxage");
 
     // validate:
     if (docroot != "" && docroot[0] != '/') {
@@ -1719,15 +1740,21 @@ void OvmsWebServer::HandleCfgWebServer(PageEntry_t& p, PageContext_t& c)
     if (docroot == "/" || docroot == "/store" || docroot == "/store/" || startsWith(docroot, "/store/ovms_config")) {
       warn += "<li data-input=\"docroot\">Document root <code>" + docroot + "</code> may open access to OVMS configuration files, consider using a sub directory</li>";
     }
+    if (cache_maxage != "" && atoi(cache_maxage.c_str()) < 0) {
+      error += "<li data-input=\"cache_maxage\">Cache lifetime must not be negative</li>";
+    }
 
     if (error == "") {
-      // success:
+      // success, write & signal config changes once:
+      OvmsConfigTransaction txn;
       if (docroot == "")      MyConfig.DeleteInstance("http.server", "docroot");
       else                    MyConfig.SetParamValue("http.server", "docroot", docroot);
       if (auth_domain == "")  MyConfig.DeleteInstance("http.server", "auth.domain");
       else                    MyConfig.SetParamValue("http.server", "auth.domain", auth_domain);
       if (auth_file == "")    MyConfig.DeleteInstance("http.server", "auth.file");
       else                    MyConfig.SetParamValue("http.server", "auth.file", auth_file);
+      if (cache_maxage == "") MyConfig.DeleteInstance("http.server", "cache.maxage");
+      else                    MyConfig.SetParamValue("http.server", "cache.maxage", cache_maxage);
 
       MyConfig.SetParamValueBool("http.server", "enable.files", enable_files);
       MyConfig.SetParamValueBool("http.server", "enable.dirlist", enable_dirlist);
@@ -1754,6 +1781,7 @@ void OvmsWebServer::HandleCfgWebServer(PageEntry_t& p, PageContext_t& c)
     docroot = MyConfig.GetParamValue("http.server", "docroot");
     auth_domain = MyConfig.GetParamValue("http.server", "auth.domain");
     auth_file = MyConfig.GetParamValue("http.server", "auth.file");
+    cache_maxage = MyConfig.GetParamValue("http.server", "cache.maxage");
     enable_files = MyConfig.GetParamValueBool("http.server", "enable.files", true);
     enable_dirlist = MyConfig.GetParamValueBool("http.server", "enable.dirlist", true);
     auth_global = MyConfig.GetParamValueBool("http.server", "auth.global", true);
@@ -1771,6 +1799,10 @@ void OvmsWebServer::HandleCfgWebServer(PageEntry_t& p, PageContext_t& c)
     " (if root path is <code>/sd</code>)</p>");
   c.input_text("Root path", "docroot", docroot.c_str(), "Default: /sd");
   c.input_checkbox("Enable directory listings", "enable_dirlist", enable_dirlist);
+  c.input("number", "Cache lifetime", "cache_maxage", cache_maxage.c_str(), "Default: 0",
+    "<p>Time browsers may use cached files without checking for changes. With 0, files are"
+    " revalidated on each use (unchanged files are not transmitted again).</p>",
+    "min=\"0\" step=\"1\"", "sec");
 
   c.input_checkbox("Enable global file auth", "auth_global", auth_global,
     "<p>If enabled, file access is globally protected by the admin password (if set).</p>"
@@ -1800,7 +1832,8 @@ void OvmsWebServer::HandleCfgWifi(PageEntry_t& p, PageContext_t& c)
   if (c.method == "POST") {
     std::string warn, error;
 
-    // process form submission:
+    // process form submission, write & signal config changes once:
+    OvmsConfigTransaction txn;
     UpdateWifiTable(p, c, "ap", "wifi.ap", warn, error, 8);
     UpdateWifiTable(p, c, "client", "wifi.ssid", warn, error, 0);
 
@@ -2200,7 +2233,8 @@ void OvmsWebServer::HandleCfgAutoInit(PageEntry_t& p, PageContext_t& c)
     }
 
     if (error == "") {
-      // success:
+      // success, write & signal config changes once:
+      OvmsConfigTransaction txn;
       MyConfig.SetParamValueBool("auto", "init", init);
       MyConfig.SetParamValueBool("auto", "dbc", dbc);
       MyConfig.SetParamValueBool("auto", "ext12v", ext12v);
@@ -2393,6 +2427,7 @@ void OvmsWebServer::HandleCfgFirmware(PageEntry_t& p, PageContext_t& c)
       }
 
       if (!error) {
+        OvmsConfigTransaction txn;
         MyConfig.SetParamValueBool("auto", "ota", auto_enable);
         MyConfig.SetParamValueBool("ota", "auto.allow.modem", auto_allow_modem);
         MyConfig.SetParamValue("ota", "auto.hour", auto_hour);
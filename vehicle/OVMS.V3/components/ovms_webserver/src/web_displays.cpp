@@ -868,6 +868,20 @@ void OvmsWebServer::HandleBmsCellMonitor(PageEntry_t& p, PageContext_t& c)
   c.print(
     "<script>\n"
     "\n"
+    "// get_delta: collect the changed element indexes of the vector metrics given,\n"
+    "//  returns null if any of them has been updated in full\n"
+    "function get_delta(update, delta, names) {\n"
+      "var idx = [], i;\n"
+      "for (i=0; i<names.length; i++) {\n"
+        "if (update[names[i]] == null)\n"
+          "continue;\n"
+        "if (!delta || !delta[names[i]])\n"
+          "return null;\n"
+        "idx = idx.concat(delta[names[i]]);\n"
+      "}\n"
+      "return idx;\n"
+    "}\n"
+    "\n"
     "/**\n"
      "* Cell voltage chart\n"
      "*/\n"
@@ -907,9 +921,9 @@ void OvmsWebServer::HandleBmsCellMonitor(PageEntry_t& p, PageContext_t& c)
       "return data;\n"
     "}\n"
     "\n"
-    "function update_volt_chart() {\n"
+    "function update_volt_chart(update, delta) {\n"
       "var data = get_volt_data();\n"
-      "voltchart.xAxis[0].setCategories(data.cells);\n"
+      "var idx = get_delta(update, delta, [\"v.b.c.voltage\", \"v.b.c.voltage.min\", \"v.b.c.voltage.max\"]);\n"
       "voltchart.yAxis[0].removePlotLine('plot-line-mean');\n"
       "voltchart.yAxis[0].addPlotLine({ id: 'plot-line-mean', className: 'plot-line-mean', value: data.voltmean, zIndex: 3 });\n"
       "voltchart.yAxis[0].removePlotLine('plot-line-sdmaxlo');\n"
@@ -918,8 +932,21 @@ void OvmsWebServer::HandleBmsCellMonitor(PageEntry_t& p, PageContext_t& c)
       "voltchart.yAxis[0].addPlotLine({ id: 'plot-line-sdmaxhi', className: 'plot-line-sdmaxhi', value: data.sdmaxhi, zIndex: 3, label: { text: 'Max Std Dev' } });\n"
       "voltchart.yAxis[0].removePlotBand('plot-band-sd');\n"
       "voltchart.yAxis[0].addPlotBand({ id: 'plot-band-sd', className: 'plot-band-sd', from: data.sdlo, to: data.sdhi });\n"
-      "voltchart.series[0].setData(data.volts);\n"
-      "voltchart.series[1].setData(data.devmax);\n"
+      "// apply cell deltas if possible, else replace all cells:\n"
+      "var i, pt, s = voltchart.series[0], full = (idx == null || s.data.length != data.volts.length);\n"
+      "for (i=0; !full && i<idx.length; i++) {\n"
+        "pt = s.data[idx[i]];\n"
+        "if (pt)\n"
+          "pt.update(data.volts[idx[i]], false);\n"
+        "else\n"
+          "full = true;\n"
+      "}\n"
+      "if (full) {\n"
+        "voltchart.xAxis[0].setCategories(data.cells, false);\n"
+        "s.setData(data.volts, false);\n"
+      "}\n"
+      "voltchart.series[1].setData(data.devmax, false);\n"
+      "voltchart.redraw();\n"
     "}\n"
     "\n"
     "function init_volt_chart() {\n"
@@ -929,13 +956,13 @@ void OvmsWebServer::HandleBmsCellMonitor(PageEntry_t& p, PageContext_t& c)
           "type: 'boxplot',\n"
           "events: {\n"
             "load: function () {\n"
-              "$('#livestatus').on(\"msg:metrics\", function(e, update){\n"
+              "$('#livestatus').on(\"msg:metrics\", function(e, update, delta){\n"
                 "if (update[\"v.b.c.voltage\"] != null\n"
                  "|| update[\"v.b.c.voltage.min\"] != null\n"
                  "|| update[\"v.b.c.voltage.max\"] != null\n"
                  "|| update[\"v.b.c.voltage.dev.max\"] != null\n"
                  "|| update[\"v.b.c.voltage.alert\"] != null)\n"
-                  "update_volt_chart();\n"
+                  "update_volt_chart(update, delta);\n"
               "});\n"
             "}\n"
           "},\n"
@@ -1047,9 +1074,9 @@ void OvmsWebServer::HandleBmsCellMonitor(PageEntry_t& p, PageContext_t& c)
       "return data;\n"
     "}\n"
     "\n"
-    "function update_temp_chart() {\n"
+    "function update_temp_chart(update, delta) {\n"
       "var data = get_temp_data();\n"
-      "tempchart.xAxis[0].setCategories(data.cells);\n"
+      "var idx = get_delta(update, delta, [\"v.b.c.temp\", \"v.b.c.temp.min\", \"v.b.c.temp.max\"]);\n"
       "tempchart.yAxis[0].removePlotLine('plot-line-mean');\n"
       "tempchart.yAxis[0].addPlotLine({ id: 'plot-line-mean', className: 'plot-line-mean', value: data.tempmean, zIndex: 3 });\n"
       "tempchart.yAxis[0].removePlotLine('plot-line-sdmaxlo');\n"
@@ -1058,8 +1085,21 @@ void OvmsWebServer::HandleBmsCellMonitor(PageEntry_t& p, PageContext_t& c)
       "tempchart.yAxis[0].addPlotLine({ id: 'plot-line-sdmaxhi', className: 'plot-line-sdmaxhi', value: data.sdmaxhi, zIndex: 3, label: { text: 'Max Std Dev' } });\n"
       "tempchart.yAxis[0].removePlotBand('plot-band-sd');\n"
       "tempchart.yAxis[0].addPlotBand({ id: 'plot-band-sd', className: 'plot-band-sd', from: data.sdlo, to: data.sdhi });\n"
-      "tempchart.series[0].setData(data.temps);\n"
-      "tempchart.series[1].setData(data.devmax);\n"
+      "// apply cell deltas if possible, else replace all cells:\n"
+      "var i, pt, s = tempchart.series[0], full = (idx == null || s.data.length != data.temps.length);\n"
+      "for (i=0; !full && i<idx.length; i++) {\n"
+        "pt = s.data[idx[i]];\n"
+        "if (pt)\n"
+          "pt.update(data.temps[idx[i]], false);\n"
+        "else\n"
+          "full = true;\n"
+      "}\n"
+      "if (full) {\n"
+        "tempchart.xAxis[0].setCategories(data.cells, false);\n"
+        "s.setData(data.temps, false);\n"
+      "}\n"
+      "tempchart.series[1].setData(data.devmax, false);\n"
+      "tempchart.redraw();\n"
     "}\n"
     "\n"
     "function init_temp_chart() {\n"
@@ -1069,13 +1109,13 @@ void OvmsWebServer::HandleBmsCellMonitor(PageEntry_t& p, PageContext_t& c)
           "type: 'boxplot',\n"
           "events: {\n"
             "load: function () {\n"
-              "$('#livestatus').on(\"msg:metrics\", function(e, update){\n"
+              "$('#livestatus').on(\"msg:metrics\", function(e, update, delta){\n"
                 "if (update[\"v.b.c.temp\"] != null\n"
                  "|| update[\"v.b.c.temp.min\"] != null\n"
                  "|| update[\"v.b.c.temp.max\"] != null\n"
                  "|| update[\"v.b.c.temp.dev.max\"] != null\n"
                  "|| update[\"v.b.c.temp.alert\"] != null)\n"
-                  "update_temp_chart();\n"
+                  "update_temp_chart(update, delta);\n"
               "});\n"
             "}\n"
           "},\n"
@@ -167,6 +167,27 @@ void PageContext::head(int code, const char* headers /*=NULL*/) {
   mg_send_head(nc, code, -1, headers);
 }
 
+/**
+ * not_modified: check conditional GET request (If-None-Match / If-Modified-Since)
+ *  If the client copy is current, a 304 response is sent and true is returned.
+ *  'headers' should repeat the Etag & cache headers of the full response.
+ *  Note: If-Modified-Since needs to match 'last_modified' exactly (as sent by browsers).
+ */
+bool PageContext::not_modified(const char* etag, const char* last_modified /*=NULL*/, const char* headers /*=NULL*/) {
+  bool match = false;
+  struct mg_str* hdr = mg_get_http_header(hm, "If-None-Match");
+  if (hdr) {
+    std::string tags(hdr->p, hdr->len);
+    match = (tags == "*" || tags.find(etag) != std::string::npos);
+  }
+  else if (last_modified && (hdr = mg_get_http_header(hm, "If-Modified-Since")) != NULL) {
+    match = (mg_vcmp(hdr, last_modified) == 0);
+  }
+  if (match)
+    mg_send_head(nc, 304, 0, headers);
+  return match;
+}
+
 void PageContext::print(const std::string text) {
   mg_send_http_chunk(nc, text.data(), text.size());
 }
@@ -806,26 +827,38 @@ void OvmsWebServer::HandleAsset(PageEntry_t& p, PageContext_t& c)
     return;
   }
 
-  char etag[50], current_time[50], last_modified[50];
+  char etag[50], current_time[50], last_modified[50], version[20], headers[300];
   time_t t = (time_t) mg_time();
   snprintf(etag, sizeof(etag), "\"%lx.%" INT64_FMT "\"", (unsigned long) mtime, (int64_t) size);
   strftime(current_time, sizeof(current_time), "%a, %d %b %Y %H:%M:%S GMT", gmtime(&t));
   strftime(last_modified, sizeof(last_modified), "%a, %d %b %Y %H:%M:%S GMT", gmtime(&mtime));
 
-  mg_send_response_line(c.nc, 200, NULL);
-  mg_printf(c.nc,
+  // Asset URLs including the version (see URL_ASSETS_*) change with the asset content,
+  // so these can be cached forever; unversioned requests need to revalidate:
+  snprintf(version, sizeof(version), "%lu", (unsigned long) mtime);
+  snprintf(headers, sizeof(headers),
     "Date: %s\r\n"
     "Last-Modified: %s\r\n"
+    "Etag: %s\r\n"
+    "Cache-Control: %s"
+    , current_time
+    , last_modified
+    , etag
+    , (c.getvar("v", 20) == version) ? "public, max-age=31536000, immutable" : "no-cache");
+
+  if (c.not_modified(etag, last_modified, headers))
+    return;
+
+  mg_send_response_line(c.nc, 200, NULL);
+  mg_printf(c.nc,
+    "%s\r\n"
     "Content-Type: %s\r\n"
     "%s"
     "Transfer-Encoding: chunked\r\n"
-    "Etag: %s\r\n"
     "\r\n"
-    , current_time
-    , last_modified
+    , headers
     , type
-    , gzip_encoded ? "Content-Encoding: gzip\r\n" : ""
-    , etag);
+    , gzip_encoded ? "Content-Encoding: gzip\r\n" : "");
 
   // start chunked transfer:
   new HttpDataSender(c.nc, data, size);
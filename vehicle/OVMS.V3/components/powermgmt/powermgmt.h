@@ -34,6 +34,7 @@
 #include <string>
 #include <map>
 #include "ovms_command.h"
+#include "ovms_events.h"
 
 #ifdef CONFIG_OVMS_COMP_WEBSERVER
 #include "ovms_webserver.h"
@@ -51,7 +52,7 @@ class powermgmt
     virtual ~powermgmt();
 
   public:
-    void Ticker1(std::string event, void* data);
+    void Ticker1(event_id_t id, const char* event, void* data);
     void ConfigChanged(std::string event, void* data);
 
   private:
@@ -105,7 +105,8 @@ Pushover::Pushover()
 
   using std::placeholders::_1;
   using std::placeholders::_2;
-  MyEvents.RegisterEvent(TAG, "*", std::bind(&Pushover::EventListener, this, _1, _2));
+  using std::placeholders::_3;
+  MyEvents.RegisterEventId(TAG, "*", std::bind(&Pushover::EventListener, this, _1, _2, _3));
 
   reader = MyNotify.RegisterReader("pushover", COMMAND_RESULT_NORMAL, std::bind(PushoverReaderCallback, _1, _2),
                                                    true, std::bind(PushoverReaderFilterCallback, _1, _2));
@@ -191,23 +192,23 @@ bool Pushover::IncomingNotification(OvmsNotifyType* type, OvmsNotifyEntry* entry
   }
 
 
-void Pushover::EventListener(std::string event, void* data)
+void Pushover::EventListener(event_id_t id, const char* event, void* data)
   {
   std::string name, setting, pri, msg, sound;
-  if ( (event == "ticker.1") || (event == "ticker.10") )
+  if (strcmp(event, "ticker.1") == 0 || strcmp(event, "ticker.10") == 0)
     return;
 
   if (MyConfig.GetParamValueBool("pushover","enable", false) == false)
     {
-    //ESP_LOGD(TAG,"EventListener: Ignore event (%s) (pushover not enabled)",event.c_str());
+    //ESP_LOGD(TAG,"EventListener: Ignore event (%s) (pushover not enabled)",event);
     return;
     }
   if (!MyNetManager.m_connected_any)
     {
-    ESP_LOGD(TAG,"EventListener: Ignore event (%s) because no network conn",event.c_str());
+    ESP_LOGD(TAG,"EventListener: Ignore event (%s) because no network conn",event);
     return;
     } 
-  ESP_LOGD(TAG,"EventListener: Handling event (%s)",event.c_str());      
+  ESP_LOGD(TAG,"EventListener: Handling event (%s)",event);      
 
   OvmsConfigParam* param = MyConfig.CachedParam("pushover");
   ConfigParamMap pmap;
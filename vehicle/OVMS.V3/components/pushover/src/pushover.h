@@ -31,6 +31,7 @@
 
 #include "ovms_config.h"
 #include "ovms_notify.h"
+#include "ovms_events.h"
 #include "ovms_buffer.h"
 #include <string>
 
@@ -56,7 +57,7 @@ class Pushover : public InternalRamAllocated
     bool sendReplyNotification;
 
   protected:
-    void EventListener(std::string event, void* data);
+    void EventListener(event_id_t id, const char* event, void* data);
 
   private:
     size_t reader;
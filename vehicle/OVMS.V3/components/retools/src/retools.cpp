@@ -756,10 +756,10 @@ class REInit
   {
   public:
     REInit();
-    void Ticker1(std::string event, void* data);
+    void Ticker1(event_id_t id, const char* event, void* data);
 } REInit  __attribute__ ((init_priority (8800)));
 
-void REInit::Ticker1(std::string event, void* data)
+void REInit::Ticker1(event_id_t id, const char* event, void* data)
   {
   if (MyRE && MyNotify.HasReader("stream", "retools.status"))
     {
@@ -816,5 +816,6 @@ REInit::REInit()
 
   using std::placeholders::_1;
   using std::placeholders::_2;
-  MyEvents.RegisterEvent(TAG, "ticker.1", std::bind(&REInit::Ticker1, this, _1, _2));
+  using std::placeholders::_3;
+  MyEvents.RegisterEventId(TAG, "ticker.1", std::bind(&REInit::Ticker1, this, _1, _2, _3));
   }
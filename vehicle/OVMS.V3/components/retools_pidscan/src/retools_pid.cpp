@@ -304,6 +304,7 @@ OvmsReToolsPidScanner::OvmsReToolsPidScanner(
     m_mfRemain(0u),
     m_task(nullptr),
     m_rxqueue(nullptr),
+    m_rxfilter(),
     m_found(),
     m_foundMutex()
 {
@@ -311,7 +312,8 @@ OvmsReToolsPidScanner::OvmsReToolsPidScanner(
     xTaskCreatePinnedToCore(
         &OvmsReToolsPidScanner::Task, "OVMS RE PID", 4096, this, 5, &m_task, CORE(1)
     );
-    MyCan.RegisterListener(m_rxqueue, true);
+    m_rxfilter.AddFilter('1' + bus->m_busnumber, rxid_low, rxid_high);
+    MyCan.RegisterListener(m_rxqueue, true, &m_rxfilter);
     m_currentPid = m_startPid - m_pidStep;
     MyEvents.RegisterEvent(
         TAG, "ticker.1",
@@ -103,6 +103,8 @@ class OvmsReToolsPidScanner
     TaskHandle_t m_task;
     /// The handle to the CAN receive queue
     QueueHandle_t m_rxqueue;
+    /// The CAN receive filter (bus & response ID range)
+    canfilter m_rxfilter;
     /// The found PIDs and the current content
     std::vector<std::tuple<uint16_t, uint16_t, std::vector<uint8_t>>> m_found;
     /// A mutex over m_found
@@ -47,7 +47,7 @@ static const char *TAG = "sdcard";
 static int insertcount = 0;
 static int mountcount = 0;
 
-void sdcard::Ticker1(std::string event, void* data)
+void sdcard::Ticker1(event_id_t id, const char* event, void* data)
   {
   if (insertcount > 0)
     {
@@ -125,7 +125,8 @@ sdcard::sdcard(const char* name, bool mode1bit, bool autoformat, int cdpin)
   #undef bind  // Kludgy, but works
   using std::placeholders::_1;
   using std::placeholders::_2;
-  MyEvents.RegisterEvent(TAG,"ticker.1", std::bind(&sdcard::Ticker1, this, _1, _2));
+  using std::placeholders::_3;
+  MyEvents.RegisterEventId(TAG,"ticker.1", std::bind(&sdcard::Ticker1, this, _1, _2, _3));
   MyEvents.RegisterEvent(TAG,"system.shuttingdown", std::bind(&sdcard::EventSystemShutDown, this, _1, _2));
   MyEvents.RegisterEvent(TAG,"system.shutdown", std::bind(&sdcard::EventSystemShutDown, this, _1, _2));
 
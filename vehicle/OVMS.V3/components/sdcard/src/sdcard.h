@@ -56,7 +56,7 @@ class sdcard : public pcp, public InternalRamAllocated
     bool isinserted();
 
   public:
-    void Ticker1(std::string event, void* data);
+    void Ticker1(event_id_t id, const char* event, void* data);
     void EventSystemShutDown(std::string event, void* data);
 
   public:
@@ -209,7 +209,8 @@ simcom::simcom(const char* name, uart_port_t uartnum, int baud, int rxpin, int t
 
   using std::placeholders::_1;
   using std::placeholders::_2;
-  MyEvents.RegisterEvent(TAG,"ticker.1", std::bind(&simcom::Ticker, this, _1, _2));
+  using std::placeholders::_3;
+  MyEvents.RegisterEventId(TAG,"ticker.1", std::bind(&simcom::Ticker, this, _1, _2, _3));
   MyEvents.RegisterEvent(TAG, "system.shuttingdown", std::bind(&simcom::EventListener, this, _1, _2));
   }
 
@@ -373,7 +374,7 @@ void simcom::SetPowerMode(PowerMode powermode)
     }
   }
 
-void simcom::Ticker(std::string event, void* data)
+void simcom::Ticker(event_id_t id, const char* event, void* data)
   {
   m_state1_ticker++;
   SimcomState1 newstate = State1Ticker1();
@@ -154,7 +154,7 @@ class simcom : public pcp, public InternalRamAllocated
     void StartTask();
     void StopTask();
     void Task();
-    void Ticker(std::string event, void* data);
+    void Ticker(event_id_t id, const char* event, void* data);
     void EventListener(std::string event, void* data);
     void IncomingMuxData(GsmMuxChannel* channel);
     void SendSetState1(SimcomState1 newstate);
@@ -63,6 +63,9 @@ OvmsVehicleFactory::OvmsVehicleFactory()
   cmd_vehicle->RegisterCommand("module","Set (or clear) vehicle module",vehicle_module,"<type>",0,1,true,vehicle_validate);
   cmd_vehicle->RegisterCommand("list","Show list of available vehicle modules",vehicle_list);
   cmd_vehicle->RegisterCommand("status","Show vehicle module status",vehicle_status);
+  OvmsCommand* cmd_poll = cmd_vehicle->RegisterCommand("poll","Poller framework");
+  OvmsCommand* cmd_pollstats = cmd_poll->RegisterCommand("stats","Show poller statistics",vehicle_poll_stats);
+  cmd_pollstats->RegisterCommand("reset","Reset poller statistics",vehicle_poll_stats_reset);
 
   MyCommandApp.RegisterCommand("wakeup","Wake up vehicle",vehicle_wakeup);
   MyCommandApp.RegisterCommand("homelink","Activate specified homelink button",vehicle_homelink,"<homelink> [<duration=1000ms>]",1,2);
@@ -234,6 +237,7 @@ OvmsVehicle::OvmsVehicle()
   {
   using std::placeholders::_1;
   using std::placeholders::_2;
+  using std::placeholders::_3;
 
   m_can1 = NULL;
   m_can2 = NULL;
@@ -270,6 +274,19 @@ OvmsVehicle::OvmsVehicle()
   m_poll_sequence_max = 1;
   m_poll_sequence_cnt = 0;
   m_poll_fc_septime = 25;       // response default timing: 25 milliseconds
+  m_poll_session_max = 1;
+  m_poll_session_busmax = 1;
+  m_poll_cycle_done = false;
+  m_poll_fast_sent = false;
+  m_poll_due_next = 0;
+  m_poll_due_valid = false;
+  m_poll_budget = 0;
+  m_poll_budget_tat = 0;
+  m_poll_stats = NULL;
+  m_poll_stats_start = 0;
+  memset(&m_poll_stats_last, 0, sizeof(m_poll_stats_last));
+  m_poll_stats_last_time = 0;
+  PollerSessionReset();
 
   m_bms_voltages = NULL;
   m_bms_vmins = NULL;
@@ -280,6 +297,7 @@ OvmsVehicle::OvmsVehicle()
   m_bms_vstddev_cnt = 0;
   m_bms_vstddev_avg = 0;
   m_bms_has_voltages = false;
+  m_bms_vdelta_minmax.lo = m_bms_vdelta_minmax.hi = 0;
 
   m_bms_temperatures = NULL;
   m_bms_tmins = NULL;
@@ -288,6 +306,7 @@ OvmsVehicle::OvmsVehicle()
   m_bms_talerts = NULL;
   m_bms_talerts_new = 0;
   m_bms_has_temperatures = false;
+  m_bms_tdelta_minmax.lo = m_bms_tdelta_minmax.hi = 0;
 
   m_bms_bitset_v.clear();
   m_bms_bitset_t.clear();
@@ -337,7 +356,7 @@ OvmsVehicle::OvmsVehicle()
   xTaskCreatePinnedToCore(OvmsVehicleRxTask, "OVMS Vehicle",
     CONFIG_OVMS_VEHICLE_RXTASK_STACK, (void*)this, 10, &m_rxtask, CORE(1));
 
-  MyEvents.RegisterEvent(TAG, "ticker.1", std::bind(&OvmsVehicle::VehicleTicker1, this, _1, _2));
+  MyEvents.RegisterEventId(TAG, "ticker.1", std::bind(&OvmsVehicle::VehicleTicker1, this, _1, _2, _3));
   MyEvents.RegisterEvent(TAG, "config.changed", std::bind(&OvmsVehicle::VehicleConfigChanged, this, _1, _2));
   MyEvents.RegisterEvent(TAG, "config.mounted", std::bind(&OvmsVehicle::VehicleConfigChanged, this, _1, _2));
   VehicleConfigChanged("config.mounted", NULL);
@@ -415,6 +434,12 @@ OvmsVehicle::~OvmsVehicle()
 
   MyEvents.DeregisterEvent(TAG);
   MyMetrics.DeregisterListener(TAG);
+
+  if (m_poll_stats)
+    {
+    delete m_poll_stats;
+    m_poll_stats = NULL;
+    }
   }
 
 const char* OvmsVehicle::VehicleShortName()
@@ -433,30 +458,23 @@ void OvmsVehicle::RxTask()
 
   while(1)
     {
-    if (xQueueReceive(m_rxqueue, &frame, (portTickType)portMAX_DELAY)==pdTRUE)
+    if (xQueueReceive(m_rxqueue, &frame, PollerWaitTime())==pdTRUE)
       {
       if (!m_ready)
         continue;
-      if (m_poll_wait && frame.origin == m_poll_bus && m_poll_plist)
+      if (m_poll_session_cnt && m_poll_plist)
         {
-        // This is a quick filter check to see if the frame is possibly intended for our poller.
-        // The filter will be checked again in PollerReceive() after locking the mutex.
-        // ESP_LOGI(TAG, "Poller Rx candidate ID=%03x (expecting %03x-%03x)",frame.MsgID,m_poll_moduleid_low,m_poll_moduleid_high);
-        uint32_t msgid;
-        if (m_poll_protocol == ISOTP_EXTADR)
-          msgid = frame.MsgID << 8 | frame.data.u8[0];
-        else
-          msgid = frame.MsgID;
-        if (msgid >= m_poll_moduleid_low && msgid <= m_poll_moduleid_high)
-          {
-          PollerReceive(&frame, msgid);
-          }
+        PollerReceive(&frame);
         }
       if (m_can1 == frame.origin) IncomingFrameCan1(&frame);
       else if (m_can2 == frame.origin) IncomingFrameCan2(&frame);
       else if (m_can3 == frame.origin) IncomingFrameCan3(&frame);
       else if (m_can4 == frame.origin) IncomingFrameCan4(&frame);
       }
+    if (m_ready && m_poll_due_valid)
+      {
+      PollerSendDue();
+      }
     }
   }
 
@@ -524,7 +542,7 @@ bool OvmsVehicle::PinCheck(char* pin)
   return (strcmp(vpin.c_str(),pin)==0);
   }
 
-void OvmsVehicle::VehicleTicker1(std::string event, void* data)
+void OvmsVehicle::VehicleTicker1(event_id_t id, const char* event, void* data)
   {
   if (!m_ready)
     return;
@@ -533,6 +551,7 @@ void OvmsVehicle::VehicleTicker1(std::string event, void* data)
 
   PollerStateTicker();
   PollerSend(true);
+  if (m_poll_stats && (m_ticker % 60) == 0) PollerStatsMetrics();
 
   Ticker1(m_ticker);
   if ((m_ticker % 10) == 0) Ticker10(m_ticker);
@@ -587,10 +606,10 @@ void OvmsVehicle::VehicleTicker1(std::string event, void* data)
     float volt = StandardMetrics.ms_v_bat_12v_voltage->AsFloat();
     // …against the maximum of default and measured reference voltage, so alerts will also
     //  be triggered if the measured ref follows a degrading battery:
-    float dref = MyConfig.GetParamValueFloat("vehicle", "12v.ref", 12.6);
+    float dref = m_12v_ref.Get();
     float vref = MAX(StandardMetrics.ms_v_bat_12v_voltage_ref->AsFloat(), dref);
     bool alert_on = StandardMetrics.ms_v_bat_12v_voltage_alert->AsBool();
-    float alert_threshold = MyConfig.GetParamValueFloat("vehicle", "12v.alert", 1.6);
+    float alert_threshold = m_12v_alert.Get();
     if (!alert_on && volt > 0 && vref > 0 && vref-volt > alert_threshold)
       {
       StandardMetrics.ms_v_bat_12v_voltage_alert->SetValue(true);
@@ -753,7 +772,7 @@ void OvmsVehicle::NotifyAlarmStopped()
 void OvmsVehicle::Notify12vCritical()
   {
   float volt = StandardMetrics.ms_v_bat_12v_voltage->AsFloat();
-  float dref = MyConfig.GetParamValueFloat("vehicle", "12v.ref", 12.6);
+  float dref = m_12v_ref.Get();
   float vref = MAX(StandardMetrics.ms_v_bat_12v_voltage_ref->AsFloat(), dref);
 
   MyNotify.NotifyStringf("alert", "batt.12v.alert", "12V Battery critical: %.1fV (ref=%.1fV)", volt, vref);
@@ -762,7 +781,7 @@ void OvmsVehicle::Notify12vCritical()
 void OvmsVehicle::Notify12vRecovered()
   {
   float volt = StandardMetrics.ms_v_bat_12v_voltage->AsFloat();
-  float dref = MyConfig.GetParamValueFloat("vehicle", "12v.ref", 12.6);
+  float dref = m_12v_ref.Get();
   float vref = MAX(StandardMetrics.ms_v_bat_12v_voltage_ref->AsFloat(), dref);
 
   MyNotify.NotifyStringf("alert", "batt.12v.recovered", "12V Battery restored: %.1fV (ref=%.1fV)", volt, vref);
@@ -1051,6 +1070,17 @@ void OvmsVehicle::VehicleConfigChanged(std::string event, void* data)
     m_brakelight_basepwr = MyConfig.GetParamValueFloat("vehicle", "brakelight.basepwr", 0);
     m_brakelight_ignftbrk = MyConfig.GetParamValueBool("vehicle", "brakelight.ignftbrk", false);
     m_brakelight_start = 0;
+
+    // poller statistics:
+    PollSetStats(MyConfig.GetParamValueBool("vehicle", "poll.stats", false));
+
+    // poller concurrency (only if configured, vehicles may set their own default):
+    if (MyConfig.IsDefined("vehicle", "poll.concurrency"))
+      {
+      PollSetConcurrency(
+        MyConfig.GetParamValueInt("vehicle", "poll.concurrency", 1),
+        MyConfig.GetParamValueInt("vehicle", "poll.concurrency.bus", 0));
+      }
     }
 
   // read vehicle specific config:
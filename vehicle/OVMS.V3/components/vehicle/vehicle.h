@@ -135,6 +135,17 @@ struct DashboardConfig;
 // Number of polling states supported
 #define VEHICLE_POLL_NSTATES            4
 
+// Max number of ISO-TP poll sessions in flight (see PollSetConcurrency())
+#define VEHICLE_POLL_MAXSESSIONS        8
+
+// Poll interval in milliseconds for poll_pid_t.polltime[] (max 32767 ms), e.g.
+//   { 0x7e2, 0x7ea, VEHICLE_POLL_TYPE_OBDIIEXTENDED, 0x1234, { 0, POLL_MS(250), POLL_MS(500) } },
+#define VEHICLE_POLL_MS                 0x8000
+#define POLL_MS(ms)                     (VEHICLE_POLL_MS | (ms))
+
+// Number of response time histogram buckets of the poller statistics (see PollSetStats())
+#define VEHICLE_POLL_STATS_BUCKETS      8
+
 // Macro for poll_pid_t termination
 #define POLL_LIST_END                   { 0, 0, 0x00, 0x00, { 0, 0, 0 }, 0, 0 }
 
@@ -208,9 +219,10 @@ class OvmsVehicle : public InternalRamAllocated
     canbus* m_can4;
 
   private:
-    void VehicleTicker1(std::string event, void* data);
+    void VehicleTicker1(event_id_t id, const char* event, void* data);
     void VehicleConfigChanged(std::string event, void* data);
     void PollerSend(bool fromTicker);
+    void PollerReceive(CAN_frame_t* frame);
     void PollerReceive(CAN_frame_t* frame, uint32_t msgid);
 
   protected:
@@ -228,6 +240,10 @@ class OvmsVehicle : public InternalRamAllocated
     int m_minsoc;            // The minimum SOC level before alert
     int m_minsoc_triggered;  // The triggered minimum SOC level to alert at
 
+  protected:
+    ConfigRef<float> m_12v_ref { "vehicle", "12v.ref", 12.6f };       // 12V default reference voltage
+    ConfigRef<float> m_12v_alert { "vehicle", "12v.alert", 1.6f };    // 12V alert threshold (voltage drop)
+
   protected:
     float m_accel_refspeed;                 // Acceleration calculation: last speed measured (m/s)
     uint32_t m_accel_reftime;               // … timestamp for refspeed (ms)
@@ -409,11 +425,54 @@ class OvmsVehicle : public InternalRamAllocated
           uint8_t data[6];                      // payload data
           } args;
         };
-      uint16_t polltime[VEHICLE_POLL_NSTATES];  // poll intervals in seconds for used poll states
+      uint16_t polltime[VEHICLE_POLL_NSTATES];  // poll intervals in seconds (or POLL_MS(ms)) for used poll states
       uint8_t  pollbus;                         // 0 = default CAN bus from PollSetPidList(), 1…4 = specific
       uint8_t  protocol;                        // ISOTP_STD / ISOTP_EXTADR
       } poll_pid_t;
 
+    typedef struct
+      {
+      uint32_t  requests;                       // requests sent
+      uint32_t  responses;                      // responses complete (including NRC responses)
+      uint32_t  timeouts;                       // requests without (complete) response
+      uint32_t  errors;                         // NRC responses (except response pending)
+      uint8_t   last_nrc;                       // last NRC code received
+      uint32_t  txfails;                        // CAN transmission failures
+      uint32_t  frames;                         // response frames received
+      uint64_t  bytes;                          // response payload bytes received
+      uint32_t  time_min;                       // response time [ms] minimum…
+      uint32_t  time_max;                       // … maximum…
+      uint64_t  time_sum;                       // … sum (average = time_sum / responses)
+      uint32_t  time_hist[VEHICLE_POLL_STATS_BUCKETS]; // response time histogram, see PollStatsOutput()
+      } poll_stats_t;
+    typedef std::map<uint64_t, poll_stats_t> poll_stats_map_t; // key: txid << 32 | type << 16 | pid
+
+    typedef struct
+      {
+      const poll_pid_t* entry;                  // poll list entry sent, NULL = session unused
+      canbus*   bus;                            // see m_poll_… members for field descriptions
+      uint8_t   protocol;
+      uint32_t  moduleid_sent;
+      uint32_t  moduleid_low;
+      uint32_t  moduleid_high;
+      uint16_t  type;
+      uint16_t  pid;
+      uint16_t  ml_remain;
+      uint16_t  ml_offset;
+      uint16_t  ml_frame;
+      uint8_t   wait;
+      uint32_t  txmsgid;
+      bool      done;                           // response complete, waiting for delivery
+      std::string rxbuf;                        // response frames waiting for delivery
+      uint32_t  sent;                           // request send time [ms]
+      poll_stats_t* stats;                      // statistics entry, NULL = statistics disabled
+      } poll_session_t;
+
+  public:
+    void PollSetStats(bool enable);
+    void PollStatsReset();
+    void PollStatsOutput(int verbosity, OvmsWriter* writer);
+
   protected:
     OvmsRecMutex      m_poll_mutex;           // Concurrency protection for recursive calls
     uint8_t           m_poll_state;           // Current poll state
@@ -446,6 +505,26 @@ class OvmsVehicle : public InternalRamAllocated
     uint8_t           m_poll_sequence_cnt;    // Polls already sent in the current time tick (second)
     uint8_t           m_poll_fc_septime;      // Flow control separation time for multi frame responses
 
+  private:
+    poll_session_t    m_poll_session[VEHICLE_POLL_MAXSESSIONS]; // ISO-TP sessions in flight
+    uint8_t           m_poll_session_cnt;     // Sessions in flight
+    uint8_t           m_poll_session_max;     // Max sessions in flight, default 1 = serialized polling
+    uint8_t           m_poll_session_busmax;  // Max sessions in flight per bus
+    int8_t            m_poll_session_cur;     // Session loaded into the m_poll_… members, -1 = none
+    int8_t            m_poll_session_rx;      // Session delivering responses to the application, -1 = none
+    std::vector<const poll_pid_t*> m_poll_sent_ahead; // Entries of the current tick sent out of list order
+    bool              m_poll_cycle_done;      // List cycle complete, next starts on ticker
+    bool              m_poll_fast_sent;       // Last request sent was a POLL_MS entry
+    std::vector<uint32_t> m_poll_due;         // Due times [ms] of the poll list entries (POLL_MS entries)
+    uint32_t          m_poll_due_next;        // Next due time [ms] of POLL_MS entries…
+    bool              m_poll_due_valid;       // … if valid
+    uint16_t          m_poll_budget;          // Max requests per second, 0 = unlimited
+    uint32_t          m_poll_budget_tat;      // Budget: theoretical arrival time [ms] of the next request
+    poll_stats_map_t* m_poll_stats;           // Statistics per request, NULL = disabled
+    uint32_t          m_poll_stats_start;     // Statistics start time [ms]
+    poll_stats_t      m_poll_stats_last;      // Statistics totals at last metrics update
+    uint32_t          m_poll_stats_last_time; // Statistics time [ms] of last metrics update
+
   private:
     OvmsRecMutex      m_poll_single_mutex;    // PollSingleRequest() concurrency protection
     std::string*      m_poll_single_rxbuf;    // … response buffer
@@ -456,6 +535,8 @@ class OvmsVehicle : public InternalRamAllocated
     void PollSetPidList(canbus* bus, const poll_pid_t* plist);
     void PollSetState(uint8_t state);
     void PollSetThrottling(uint8_t sequence_max);
+    void PollSetConcurrency(uint8_t sessions_max, uint8_t sessions_per_bus=0);
+    void PollSetBudget(uint16_t requests_per_second);
     void PollSetResponseSeparationTime(uint8_t septime);
     int PollSingleRequest(canbus* bus, uint32_t txid, uint32_t rxid,
                       std::string request, std::string& response,
@@ -470,12 +551,39 @@ class OvmsVehicle : public InternalRamAllocated
 
   private:
     void PollerTxCallback(const CAN_frame_t* frame, bool success);
+    canbus* PollerGetBus(uint8_t pollbus);
+    bool PollerSessionStart(const poll_pid_t* entry, bool fromTicker);
+    bool PollerBudgetAvailable(uint32_t now);
+    void PollerSendFast(bool fromTicker);
+    void PollerSendList(bool fromTicker);
+    void PollerResetDue();
+    TickType_t PollerWaitTime();
+    void PollerSendDue();
+    void PollerSessionLoad(int index);
+    void PollerSessionSave(int index);
+    void PollerSessionClose(int index);
+    void PollerSessionReset();
+    void PollerDeliver(canbus* bus, uint8_t* data, uint8_t length);
+    void PollerDeliverError(canbus* bus, uint16_t code);
+    void PollerFlush();
+    void PollerStatsTotal(poll_stats_t &total);
+    void PollerStatsMetrics();
   protected:
     virtual void IncomingPollTxCallback(canbus* bus, uint32_t txid, uint16_t type, uint16_t pid, bool success);
 
 
   // BMS helpers
   protected:
+    typedef struct
+      {
+      int lo, hi;                             // changed index range [lo,hi), empty if hi==0
+      } bms_delta_t;
+    static inline void BmsDeltaAdd(bms_delta_t &delta, int index)
+      {
+      if (delta.hi == 0) { delta.lo = index; delta.hi = index+1; }
+      else if (index < delta.lo) delta.lo = index;
+      else if (index >= delta.hi) delta.hi = index+1;
+      }
     float* m_bms_voltages;                    // BMS voltages (current value)
     float* m_bms_vmins;                       // BMS minimum voltages seen (since reset)
     float* m_bms_vmaxs;                       // BMS maximum voltages seen (since reset)
@@ -485,6 +593,7 @@ class OvmsVehicle : public InternalRamAllocated
     int m_bms_vstddev_cnt;                    // BMS internal stddev counter
     float m_bms_vstddev_avg;                  // BMS internal stddev average
     bool m_bms_has_voltages;                  // True if BMS has a complete set of voltage values
+    bms_delta_t m_bms_vdelta_minmax;          // BMS changed range of vmins/vmaxs (since last publish)
     float* m_bms_temperatures;                // BMS temperatures (celcius current value)
     float* m_bms_tmins;                       // BMS minimum temperatures seen (since reset)
     float* m_bms_tmaxs;                       // BMS maximum temperatures seen (since reset)
@@ -492,6 +601,7 @@ class OvmsVehicle : public InternalRamAllocated
     short* m_bms_talerts;                     // BMS temperature deviation alerts (since reset)
     int m_bms_talerts_new;                    // BMS new temperature alerts since last notification
     bool m_bms_has_temperatures;              // True if BMS has a complete set of temperature values
+    bms_delta_t m_bms_tdelta_minmax;          // BMS changed range of tmins/tmaxs (since last publish)
     std::vector<bool> m_bms_bitset_v;         // BMS tracking: true if corresponding voltage set
     std::vector<bool> m_bms_bitset_t;         // BMS tracking: true if corresponding temperature set
     int m_bms_bitset_cv;                      // BMS tracking: count of unique voltage values set
@@ -586,6 +696,8 @@ class OvmsVehicleFactory
     static void vehicle_module(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv);
     static void vehicle_list(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv);
     static void vehicle_status(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv);
+    static void vehicle_poll_stats(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv);
+    static void vehicle_poll_stats_reset(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv);
     static void vehicle_wakeup(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv);
     static void vehicle_homelink(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv);
     static void vehicle_climatecontrol(int verbosity, OvmsWriter* writer, bool on);
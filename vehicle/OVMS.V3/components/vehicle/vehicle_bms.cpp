@@ -32,6 +32,7 @@
 static const char *TAG = "vehicle";
 
 #include <stdio.h>
+#include <math.h>
 #include <algorithm>
 #include <ovms_command.h>
 #include <ovms_script.h>
@@ -48,6 +49,88 @@ static const char *TAG = "vehicle";
 // Voltage stddev running average sample count:
 #define VSTDDEV_SMOOTHCNT         5
 
+/**
+ * BmsCellStats: single pass statistics for a complete cell value series
+ *
+ *  Calculates min, max, average, standard deviation and gradient (linear
+ *  regression slope over the cell index, scaled to the series length) in one
+ *  fused loop. Sums are accumulated relative to the first value in single
+ *  precision (the ESP32 FPU has no double support), which keeps the squares
+ *  small enough to resolve sub-millivolt deviations. Four independent lanes
+ *  break up the dependency chains, allowing the compiler to pipeline resp.
+ *  vectorize the loop.
+ */
+typedef struct
+  {
+  float min, max, avg, stddev, grad;
+  } bms_stats_t;
+
+static void BmsCellStats(const float* values, int count, bms_stats_t &st)
+  {
+  const float ref = values[0];
+  const float mid = (count - 1) * 0.5f;
+  float sum[4] = { 0, 0, 0, 0 };
+  float sqr[4] = { 0, 0, 0, 0 };
+  float wsum[4] = { 0, 0, 0, 0 };
+  float min[4] = { ref, ref, ref, ref };
+  float max[4] = { ref, ref, ref, ref };
+  float pos[4] = { -mid, 1-mid, 2-mid, 3-mid };
+
+  int i = 0;
+  for (; i+4 <= count; i += 4)
+    {
+    for (int k=0; k<4; k++)
+      {
+      float v = values[i+k];
+      float d = v - ref;
+      sum[k] += d;
+      sqr[k] += d * d;
+      wsum[k] += pos[k] * d;
+      min[k] = (v < min[k]) ? v : min[k];
+      max[k] = (v > max[k]) ? v : max[k];
+      pos[k] += 4;
+      }
+    }
+  for (; i < count; i++)
+    {
+    float v = values[i];
+    float d = v - ref;
+    sum[0] += d;
+    sqr[0] += d * d;
+    wsum[0] += (i - mid) * d;
+    min[0] = (v < min[0]) ? v : min[0];
+    max[0] = (v > max[0]) ? v : max[0];
+    }
+
+  float n = count;
+  float dsum = (sum[0] + sum[1]) + (sum[2] + sum[3]);
+  float dsqr = (sqr[0] + sqr[1]) + (sqr[2] + sqr[3]);
+  float dwsum = (wsum[0] + wsum[1]) + (wsum[2] + wsum[3]);
+  float davg = dsum / n;
+  st.min = std::min(std::min(min[0], min[1]), std::min(min[2], min[3]));
+  st.max = std::max(std::max(max[0], max[1]), std::max(max[2], max[3]));
+  st.avg = ref + davg;
+  st.stddev = sqrtf(LIMIT_MIN(dsqr / n - SQR(davg), 0));
+  // The index offsets sum up to zero, so Σ(i-mid)*(v-avg) == Σ(i-mid)*(v-ref),
+  // and Σ(i-mid)² == n*(n²-1)/12:
+  st.grad = (count > 1) ? dwsum / (n * (SQR(n) - 1) / 12) * n : 0;
+  }
+
+/**
+ * BmsPublish: update a cell vector metric with the changed range only
+ *  Falls back to a full update if the metric size does not match the
+ *  series (i.e. after a reset).
+ */
+template <typename ElemType, class Allocator>
+static void BmsPublish(OvmsMetricVector<ElemType, Allocator>* metric,
+  const ElemType* values, int count, int lo, int hi)
+  {
+  if (metric->GetSize() != (uint32_t)count)
+    metric->SetElemValues(0, count, values);
+  else if (hi > lo)
+    metric->SetElemValues(lo, hi-lo, values+lo);
+  }
+
 
 void OvmsVehicle::BmsSetCellArrangementVoltage(int readings, int readingspermodule)
   {
@@ -162,11 +245,18 @@ void OvmsVehicle::BmsSetCellVoltage(int index, float value)
     {
     m_bms_vmins[index] = value;
     m_bms_vmaxs[index] = value;
+    BmsDeltaAdd(m_bms_vdelta_minmax, index);
     }
   else if (m_bms_vmins[index] > value)
+    {
     m_bms_vmins[index] = value;
+    BmsDeltaAdd(m_bms_vdelta_minmax, index);
+    }
   else if (m_bms_vmaxs[index] < value)
+    {
     m_bms_vmaxs[index] = value;
+    BmsDeltaAdd(m_bms_vdelta_minmax, index);
+    }
 
   if (m_bms_bitset_v[index] == false) m_bms_bitset_cv++;
   if (m_bms_bitset_cv == m_bms_readings_v)
@@ -177,39 +267,23 @@ void OvmsVehicle::BmsSetCellVoltage(int index, float value)
     float thr_warn     = MyConfig.GetParamValueFloat("vehicle", "bms.dev.voltage.warn",     m_bms_defthr_vwarn);
     float thr_alert    = MyConfig.GetParamValueFloat("vehicle", "bms.dev.voltage.alert",    m_bms_defthr_valert);
 
-    // Get min, max, avg & standard deviation:
-    double sum=0, sqrsum=0, avg, stddev=0;
-    float min=0, max=0;
-    for (int i=0; i<m_bms_readings_v; i++)
-      {
-      sum += m_bms_voltages[i];
-      sqrsum += SQR(m_bms_voltages[i]);
-      if (min==0 || m_bms_voltages[i]<min)
-        min = m_bms_voltages[i];
-      if (max==0 || m_bms_voltages[i]>max)
-        max = m_bms_voltages[i];
-      }
-    avg = sum / m_bms_readings_v;
-    stddev = sqrt(LIMIT_MIN((sqrsum / m_bms_readings_v) - SQR(avg), 0));
-
-    // Get gradient:
-    double sumn = 0, sumd = 0;
-    for (int i=0; i<m_bms_readings_v; i++)
-      {
-      sumn += (i - (m_bms_readings_v / 2 - 0.5)) * (m_bms_voltages[i] - avg);
-      sumd += SQR(i - (m_bms_readings_v / 2 - 0.5));
-      }
-    float grad = (sumn / sumd) * m_bms_readings_v;
+    // Get min, max, avg, standard deviation & gradient:
+    bms_stats_t st;
+    BmsCellStats(m_bms_voltages, m_bms_readings_v, st);
+    float avg = st.avg, stddev = st.stddev, grad = st.grad;
 
     // …publish to metrics:
-    StandardMetrics.ms_v_bat_pack_vmin->SetValue(min);
-    StandardMetrics.ms_v_bat_pack_vmax->SetValue(max);
+    StandardMetrics.ms_v_bat_pack_vmin->SetValue(st.min);
+    StandardMetrics.ms_v_bat_pack_vmax->SetValue(st.max);
     StandardMetrics.ms_v_bat_pack_vavg->SetValue(ROUNDPREC(avg, 5));
     StandardMetrics.ms_v_bat_pack_vstddev->SetValue(ROUNDPREC(stddev, 5));
     StandardMetrics.ms_v_bat_pack_vgrad->SetValue(ROUNDPREC(grad, 5));
     StandardMetrics.ms_v_bat_cell_voltage->SetElemValues(0, m_bms_readings_v, m_bms_voltages);
-    StandardMetrics.ms_v_bat_cell_vmin->SetElemValues(0, m_bms_readings_v, m_bms_vmins);
-    StandardMetrics.ms_v_bat_cell_vmax->SetElemValues(0, m_bms_readings_v, m_bms_vmaxs);
+    BmsPublish(StandardMetrics.ms_v_bat_cell_vmin, m_bms_vmins, m_bms_readings_v,
+      m_bms_vdelta_minmax.lo, m_bms_vdelta_minmax.hi);
+    BmsPublish(StandardMetrics.ms_v_bat_cell_vmax, m_bms_vmaxs, m_bms_readings_v,
+      m_bms_vdelta_minmax.lo, m_bms_vdelta_minmax.hi);
+    m_bms_vdelta_minmax.lo = m_bms_vdelta_minmax.hi = 0;
 
     // Voltages are very volatile and may respond to a load change within the sensor query loop.
     // To detect an inconsistent series, we check for a too high gradient and/or a too high
@@ -239,26 +313,36 @@ void OvmsVehicle::BmsSetCellVoltage(int index, float value)
     // Check cell deviations only if the series appears to be consistent:
     if (series_valid)
       {
-      float dev;
+      float dev, absdev;
+      float lim_warn = stddev + thr_warn, lim_alert = stddev + thr_alert;
+      bms_delta_t delta = { 0, 0 };
       for (int i=0; i<m_bms_readings_v; i++)
         {
-        dev = ROUNDPREC(m_bms_voltages[i] - avg, 5);
-        if (ABS(dev) > ABS(m_bms_vdevmaxs[i]))
+        dev = roundf((m_bms_voltages[i] - avg) * 1e5f) / 1e5f;
+        absdev = ABS(dev);
+        if (absdev > ABS(m_bms_vdevmaxs[i]))
+          {
           m_bms_vdevmaxs[i] = dev;
-        if (ABS(dev) >= stddev + thr_alert && m_bms_valerts[i] < 2)
+          BmsDeltaAdd(delta, i);
+          }
+        if (absdev >= lim_alert && m_bms_valerts[i] < 2)
           {
           m_bms_valerts[i] = 2;
           m_bms_valerts_new++; // trigger notification
+          BmsDeltaAdd(delta, i);
           }
-        else if (ABS(dev) >= stddev + thr_warn && m_bms_valerts[i] < 1)
+        else if (absdev >= lim_warn && m_bms_valerts[i] < 1)
+          {
           m_bms_valerts[i] = 1;
+          BmsDeltaAdd(delta, i);
+          }
         }
 
       // Publish deviation maximums & alerts:
       if (stddev > StandardMetrics.ms_v_bat_pack_vstddev_max->AsFloat())
         StandardMetrics.ms_v_bat_pack_vstddev_max->SetValue(stddev);
-      StandardMetrics.ms_v_bat_cell_vdevmax->SetElemValues(0, m_bms_readings_v, m_bms_vdevmaxs);
-      StandardMetrics.ms_v_bat_cell_valert->SetElemValues(0, m_bms_readings_v, m_bms_valerts);
+      BmsPublish(StandardMetrics.ms_v_bat_cell_vdevmax, m_bms_vdevmaxs, m_bms_readings_v, delta.lo, delta.hi);
+      BmsPublish(StandardMetrics.ms_v_bat_cell_valert, m_bms_valerts, m_bms_readings_v, delta.lo, delta.hi);
       }
 
     // complete:
@@ -284,11 +368,18 @@ void OvmsVehicle::BmsSetCellTemperature(int index, float value)
     {
     m_bms_tmins[index] = value;
     m_bms_tmaxs[index] = value;
+    BmsDeltaAdd(m_bms_tdelta_minmax, index);
     }
   else if (m_bms_tmins[index] > value)
+    {
     m_bms_tmins[index] = value;
+    BmsDeltaAdd(m_bms_tdelta_minmax, index);
+    }
   else if (m_bms_tmaxs[index] < value)
+    {
     m_bms_tmaxs[index] = value;
+    BmsDeltaAdd(m_bms_tdelta_minmax, index);
+    }
 
   if (m_bms_bitset_t[index] == false) m_bms_bitset_ct++;
   if (m_bms_bitset_ct == m_bms_readings_t)
@@ -298,50 +389,53 @@ void OvmsVehicle::BmsSetCellTemperature(int index, float value)
     float thr_alert = MyConfig.GetParamValueFloat("vehicle", "bms.dev.temp.alert", m_bms_defthr_talert);
 
     // get min, max, avg & standard deviation:
-    double sum=0, sqrsum=0, avg, stddev=0;
-    float min=0, max=0;
-    for (int i=0; i<m_bms_readings_t; i++)
-      {
-      sum += m_bms_temperatures[i];
-      sqrsum += SQR(m_bms_temperatures[i]);
-      if (min==0 || m_bms_temperatures[i]<min)
-        min = m_bms_temperatures[i];
-      if (max==0 || m_bms_temperatures[i]>max)
-        max = m_bms_temperatures[i];
-      }
-    avg = sum / m_bms_readings_t;
-    stddev = sqrt(LIMIT_MIN((sqrsum / m_bms_readings_t) - SQR(avg), 0));
+    bms_stats_t st;
+    BmsCellStats(m_bms_temperatures, m_bms_readings_t, st);
+    float avg = st.avg, stddev = st.stddev;
 
     // check cell deviations:
-    float dev;
+    float dev, absdev;
+    float lim_warn = stddev + thr_warn, lim_alert = stddev + thr_alert;
+    bms_delta_t delta = { 0, 0 };
     for (int i=0; i<m_bms_readings_t; i++)
       {
-      dev = ROUNDPREC(m_bms_temperatures[i] - avg, 2);
-      if (ABS(dev) > ABS(m_bms_tdevmaxs[i]))
+      dev = roundf((m_bms_temperatures[i] - avg) * 1e2f) / 1e2f;
+      absdev = ABS(dev);
+      if (absdev > ABS(m_bms_tdevmaxs[i]))
+        {
         m_bms_tdevmaxs[i] = dev;
-      if (ABS(dev) >= stddev + thr_alert && m_bms_talerts[i] < 2)
+        BmsDeltaAdd(delta, i);
+        }
+      if (absdev >= lim_alert && m_bms_talerts[i] < 2)
         {
         m_bms_talerts[i] = 2;
         m_bms_talerts_new++; // trigger notification
+        BmsDeltaAdd(delta, i);
         }
-      else if (ABS(dev) >= stddev + thr_warn && m_bms_valerts[i] < 1)
+      else if (absdev >= lim_warn && m_bms_talerts[i] < 1)
+        {
         m_bms_talerts[i] = 1;
+        BmsDeltaAdd(delta, i);
+        }
       }
 
     // publish to metrics:
     avg = ROUNDPREC(avg, 2);
     stddev = ROUNDPREC(stddev, 2);
-    StandardMetrics.ms_v_bat_pack_tmin->SetValue(min);
-    StandardMetrics.ms_v_bat_pack_tmax->SetValue(max);
+    StandardMetrics.ms_v_bat_pack_tmin->SetValue(st.min);
+    StandardMetrics.ms_v_bat_pack_tmax->SetValue(st.max);
     StandardMetrics.ms_v_bat_pack_tavg->SetValue(avg);
     StandardMetrics.ms_v_bat_pack_tstddev->SetValue(stddev);
     if (stddev > StandardMetrics.ms_v_bat_pack_tstddev_max->AsFloat())
       StandardMetrics.ms_v_bat_pack_tstddev_max->SetValue(stddev);
     StandardMetrics.ms_v_bat_cell_temp->SetElemValues(0, m_bms_readings_t, m_bms_temperatures);
-    StandardMetrics.ms_v_bat_cell_tmin->SetElemValues(0, m_bms_readings_t, m_bms_tmins);
-    StandardMetrics.ms_v_bat_cell_tmax->SetElemValues(0, m_bms_readings_t, m_bms_tmaxs);
-    StandardMetrics.ms_v_bat_cell_tdevmax->SetElemValues(0, m_bms_readings_t, m_bms_tdevmaxs);
-    StandardMetrics.ms_v_bat_cell_talert->SetElemValues(0, m_bms_readings_t, m_bms_talerts);
+    BmsPublish(StandardMetrics.ms_v_bat_cell_tmin, m_bms_tmins, m_bms_readings_t,
+      m_bms_tdelta_minmax.lo, m_bms_tdelta_minmax.hi);
+    BmsPublish(StandardMetrics.ms_v_bat_cell_tmax, m_bms_tmaxs, m_bms_readings_t,
+      m_bms_tdelta_minmax.lo, m_bms_tdelta_minmax.hi);
+    m_bms_tdelta_minmax.lo = m_bms_tdelta_minmax.hi = 0;
+    BmsPublish(StandardMetrics.ms_v_bat_cell_tdevmax, m_bms_tdevmaxs, m_bms_readings_t, delta.lo, delta.hi);
+    BmsPublish(StandardMetrics.ms_v_bat_cell_talert, m_bms_talerts, m_bms_readings_t, delta.lo, delta.hi);
 
     // complete:
     m_bms_has_temperatures = true;
@@ -377,6 +471,7 @@ void OvmsVehicle::BmsResetCellVoltages(bool full /*=false*/)
     m_bms_bitset_v.resize(m_bms_readings_v);
     m_bms_bitset_cv = 0;
     m_bms_has_voltages = false;
+    m_bms_vdelta_minmax.lo = m_bms_vdelta_minmax.hi = 0;
     for (int k=0; k<m_bms_readings_v; k++)
       {
       m_bms_vmins[k] = 0;
@@ -404,6 +499,7 @@ void OvmsVehicle::BmsResetCellTemperatures(bool full /*=false*/)
     m_bms_bitset_t.resize(m_bms_readings_t);
     m_bms_bitset_ct = 0;
     m_bms_has_temperatures = false;
+    m_bms_tdelta_minmax.lo = m_bms_tdelta_minmax.hi = 0;
     for (int k=0; k<m_bms_readings_t; k++)
       {
       m_bms_tmins[k] = 0;
@@ -43,8 +43,34 @@ static const char *TAG = "vehicle";
 #endif // #ifdef CONFIG_OVMS_COMP_WEBSERVER
 #include <ovms_peripherals.h>
 #include <string_writer.h>
+#include "esp_timer.h"
 #include "vehicle.h"
 
+// Session rxbuf record length marking a queued error response (frame payloads are shorter):
+#define POLLER_RXBUF_ERROR 0xFF
+
+static inline uint32_t PollerTime()
+  {
+  return esp_timer_get_time() / 1000;
+  }
+
+// Response time histogram bucket limits [ms] (last bucket: slower responses):
+static const uint32_t poll_stats_bucket_ms[VEHICLE_POLL_STATS_BUCKETS-1] = { 10, 20, 50, 100, 200, 500, 1000 };
+
+static void PollerStatsAddTime(OvmsVehicle::poll_stats_t* stats, uint32_t ms)
+  {
+  int bucket = 0;
+  while (bucket < VEHICLE_POLL_STATS_BUCKETS-1 && ms >= poll_stats_bucket_ms[bucket])
+    bucket++;
+  stats->time_hist[bucket]++;
+  if (stats->responses == 0 || ms < stats->time_min)
+    stats->time_min = ms;
+  if (ms > stats->time_max)
+    stats->time_max = ms;
+  stats->time_sum += ms;
+  stats->responses++;
+  }
+
 
 /**
  * PollerStateTicker: check for state changes (stub, override with vehicle implementation)
@@ -62,6 +88,9 @@ void OvmsVehicle::PollerStateTicker()
  *  This is called by PollerReceive() on each valid response frame for the current request.
  *  Be aware responses may consist of multiple frames, detectable e.g. by mlremain > 0.
  *  A typical pattern is to collect frames in a buffer until mlremain == 0.
+ *  Responses are delivered one at a time, also with concurrent polling enabled (see
+ *  PollSetConcurrency()): frames of other responses are queued until the current response
+ *  is complete. The m_poll_… members reflect the request the response belongs to.
  *  
  *  @param bus
  *    CAN bus the current poll is done on
@@ -159,9 +188,9 @@ void OvmsVehicle::PollSetPidList(canbus* bus, const poll_pid_t* plist)
   m_poll_plist = plist;
   m_poll_ticker = 0;
   m_poll_sequence_cnt = 0;
-  m_poll_wait = 0;
   m_poll_plcur = NULL;
-  m_poll_txmsgid = 0;
+  PollerSessionReset();
+  PollerResetDue();
   }
 
 
@@ -183,9 +212,9 @@ void OvmsVehicle::PollSetState(uint8_t state)
     m_poll_state = state;
     m_poll_ticker = 0;
     m_poll_sequence_cnt = 0;
-    m_poll_wait = 0;
     m_poll_plcur = NULL;
-    m_poll_txmsgid = 0;
+    PollerSessionReset();
+    PollerResetDue();
     }
   }
 
@@ -199,6 +228,9 @@ void OvmsVehicle::PollSetState(uint8_t state)
  *  @param sequence_max
  *    Polls allowed to be sent in sequence per time tick (second), default 1, 0 = no limit.
  *  
+ *  Note: this applies to entries with intervals in seconds, POLL_MS() entries are sent
+ *  when due. Use PollSetBudget() to limit the overall request rate.
+ *  
  *  The configuration is kept unchanged over calls to PollSetPidList() or PollSetState().
  */
 void OvmsVehicle::PollSetThrottling(uint8_t sequence_max)
@@ -208,6 +240,57 @@ void OvmsVehicle::PollSetThrottling(uint8_t sequence_max)
   }
 
 
+/**
+ * PollSetConcurrency: configure concurrent polling of multiple ECUs
+ *  By default, the poller sends one request and waits for the response (or timeout) before
+ *  sending the next. With concurrency enabled, requests to different ECUs (rxmoduleid) are
+ *  sent without waiting, each ECU keeping its own ISO-TP session. Requests to the same ECU
+ *  are always serialized, as are broadcast requests (these need the bus exclusively).
+ *  
+ *  Responses are still passed to IncomingPollReply() one at a time, so handlers collecting
+ *  multi frame responses in a shared buffer need no change.
+ *  
+ *  Note: the throttling limit (PollSetThrottling()) still applies to the number of requests
+ *  sent per tick, set it accordingly.
+ *  
+ *  @param sessions_max
+ *    Max number of requests in flight in total, 1 = no concurrency (default),
+ *    up to VEHICLE_POLL_MAXSESSIONS.
+ *  @param sessions_per_bus
+ *    Max number of requests in flight per CAN bus, 0 = same as sessions_max.
+ *  
+ *  The configuration is kept unchanged over calls to PollSetPidList() or PollSetState().
+ */
+void OvmsVehicle::PollSetConcurrency(uint8_t sessions_max, uint8_t sessions_per_bus /*=0*/)
+  {
+  OvmsRecMutexLock lock(&m_poll_mutex);
+  m_poll_session_max = LIMIT_MAX(sessions_max, VEHICLE_POLL_MAXSESSIONS);
+  if (m_poll_session_max == 0) m_poll_session_max = 1;
+  if (sessions_per_bus == 0 || sessions_per_bus > m_poll_session_max)
+    m_poll_session_busmax = m_poll_session_max;
+  else
+    m_poll_session_busmax = sessions_per_bus;
+  }
+
+
+/**
+ * PollSetBudget: configure the poller bus load budget
+ *  Limits the rate of requests sent by the poller (all entries, including POLL_MS() entries),
+ *  allowing bursts of up to one second's worth of requests.
+ *  
+ *  @param requests_per_second
+ *    Max average requests per second, 0 = unlimited (default).
+ *  
+ *  The configuration is kept unchanged over calls to PollSetPidList() or PollSetState().
+ */
+void OvmsVehicle::PollSetBudget(uint16_t requests_per_second)
+  {
+  OvmsRecMutexLock lock(&m_poll_mutex);
+  m_poll_budget = requests_per_second;
+  m_poll_budget_tat = PollerTime();
+  }
+
+
 /**
  * PollSetResponseSeparationTime: configure ISO TP multi frame response timing
  *  See: https://en.wikipedia.org/wiki/ISO_15765-2
@@ -229,139 +312,661 @@ void OvmsVehicle::PollSetResponseSeparationTime(uint8_t septime)
 
 
 /**
- * PollerSend: internal: start next due request
+ * PollSetStats: enable/disable poller statistics
+ *  Statistics are collected per request (txid/type/pid) and include response times,
+ *  timeouts, NRC responses & response sizes. See "vehicle poll stats" for the output,
+ *  and the m.poll.* metrics for summaries updated once per minute.
+ *  Disabled statistics cost nothing (no memory, a pointer check per response frame).
+ *  
+ *  This is normally controlled by the config parameter [vehicle] poll.stats (default: off).
+ *  
+ *  @param enable
+ *    true = start collecting statistics (if not already running), false = stop & discard
  */
-void OvmsVehicle::PollerSend(bool fromTicker)
+void OvmsVehicle::PollSetStats(bool enable)
   {
   OvmsRecMutexLock lock(&m_poll_mutex);
+  if (enable == (m_poll_stats != NULL))
+    return;
+  if (enable)
+    {
+    m_poll_stats = new poll_stats_map_t();
+    PollStatsReset();
+    }
+  else
+    {
+    for (int i = 0; i < VEHICLE_POLL_MAXSESSIONS; i++)
+      m_poll_session[i].stats = NULL;
+    delete m_poll_stats;
+    m_poll_stats = NULL;
+    }
+  }
 
-  // Don't do anything with no bus, no list or an empty list
-  if (!m_poll_bus_default || !m_poll_plist || m_poll_plist->txmoduleid == 0) return;
 
-  if (m_poll_plcur == NULL) m_poll_plcur = m_poll_plist;
+/**
+ * PollStatsReset: clear poller statistics
+ *  Requests in flight are not accounted for.
+ */
+void OvmsVehicle::PollStatsReset()
+  {
+  OvmsRecMutexLock lock(&m_poll_mutex);
+  if (!m_poll_stats)
+    return;
+  for (int i = 0; i < VEHICLE_POLL_MAXSESSIONS; i++)
+    m_poll_session[i].stats = NULL;
+  m_poll_stats->clear();
+  m_poll_stats_start = m_poll_stats_last_time = PollerTime();
+  memset(&m_poll_stats_last, 0, sizeof(m_poll_stats_last));
+  }
 
-  // ESP_LOGD(TAG, "PollerSend(%d): entry at[type=%02X, pid=%X], ticker=%u, wait=%u, cnt=%u/%u",
-  //          fromTicker, m_poll_plcur->type, m_poll_plcur->pid,
-  //          m_poll_ticker, m_poll_wait, m_poll_sequence_cnt, m_poll_sequence_max);
 
-  if (fromTicker)
+/**
+ * PollStatsOutput: output poller statistics (shell command "vehicle poll stats")
+ */
+void OvmsVehicle::PollStatsOutput(int verbosity, OvmsWriter* writer)
+  {
+  poll_stats_map_t stats;
+  poll_stats_t total;
+  uint32_t seconds = 0;
+
+  m_poll_mutex.Lock();
+  if (m_poll_stats)
     {
-    // Timer ticker call: reset throttling counter, check response timeout
-    m_poll_sequence_cnt = 0;
-    if (m_poll_wait > 0) m_poll_wait--;
+    stats = *m_poll_stats;
+    PollerStatsTotal(total);
+    seconds = (PollerTime() - m_poll_stats_start) / 1000;
     }
-  if (m_poll_wait > 0) return;
+  m_poll_mutex.Unlock();
 
-  while (m_poll_plcur->txmoduleid != 0)
+  if (stats.empty())
     {
-    if ((m_poll_plcur->polltime[m_poll_state] > 0) &&
-        ((m_poll_ticker % m_poll_plcur->polltime[m_poll_state]) == 0))
+    writer->puts(MyConfig.GetParamValueBool("vehicle", "poll.stats", false)
+      ? "No poller statistics collected yet"
+      : "Poller statistics disabled, enable by: config set vehicle poll.stats yes");
+    return;
+    }
+  if (seconds == 0)
+    seconds = 1;
+
+  writer->printf("Poller statistics for the last %u seconds:\n", seconds);
+  writer->printf("  Requests: %u (%.2f/s), responses: %u, timeouts: %u, NRCs: %u, TX failures: %u\n",
+    total.requests, (float) total.requests / seconds, total.responses,
+    total.timeouts, total.errors, total.txfails);
+  writer->printf("  Response frames: %u, bytes: %llu, time: avg %u ms, min %u ms, max %u ms\n",
+    total.frames, total.bytes, total.responses ? (uint32_t)(total.time_sum / total.responses) : 0,
+    total.time_min, total.time_max);
+
+  if (verbosity < COMMAND_RESULT_NORMAL)
+    return;
+
+  writer->puts("\nRequests:");
+  writer->puts("  TXID     Type PID      Sent  Rate/s    Resp   T/O   NRC Last TxErr  Frames      Bytes");
+  for (auto &it : stats)
+    {
+    const poll_stats_t &st = it.second;
+    char nrc[4] = "-";
+    if (st.errors)
+      snprintf(nrc, sizeof(nrc), "%02x", st.last_nrc);
+    writer->printf("  %-8x %02x   %-5x %7u %7.2f %7u %5u %5u %4s %5u %7u %10llu\n",
+      (uint32_t)(it.first >> 32), (uint32_t)(it.first >> 16) & 0xff, (uint32_t)it.first & 0xffff,
+      st.requests, (float) st.requests / seconds, st.responses, st.timeouts, st.errors,
+      nrc,
+      st.txfails, st.frames, st.bytes);
+    }
+
+  writer->puts("\nResponse times [ms]:");
+  writer->puts("  TXID     Type PID     Avg   Min   Max   <10   <20   <50  <100  <200  <500   <1s  >=1s");
+  for (auto &it : stats)
+    {
+    const poll_stats_t &st = it.second;
+    if (st.responses == 0)
+      continue;
+    writer->printf("  %-8x %02x   %-5x %5u %5u %5u",
+      (uint32_t)(it.first >> 32), (uint32_t)(it.first >> 16) & 0xff, (uint32_t)it.first & 0xffff,
+      (uint32_t)(st.time_sum / st.responses), st.time_min, st.time_max);
+    for (int i = 0; i < VEHICLE_POLL_STATS_BUCKETS; i++)
+      writer->printf(" %5u", st.time_hist[i]);
+    writer->puts("");
+    }
+  }
+
+
+/**
+ * PollerStatsTotal: internal: sum up statistics of all requests
+ */
+void OvmsVehicle::PollerStatsTotal(poll_stats_t &total)
+  {
+  memset(&total, 0, sizeof(total));
+  if (!m_poll_stats)
+    return;
+  for (auto &it : *m_poll_stats)
+    {
+    const poll_stats_t &st = it.second;
+    if (st.responses && (total.responses == 0 || st.time_min < total.time_min))
+      total.time_min = st.time_min;
+    if (st.time_max > total.time_max)
+      total.time_max = st.time_max;
+    total.requests += st.requests;
+    total.responses += st.responses;
+    total.timeouts += st.timeouts;
+    total.errors += st.errors;
+    total.txfails += st.txfails;
+    total.frames += st.frames;
+    total.bytes += st.bytes;
+    total.time_sum += st.time_sum;
+    for (int i = 0; i < VEHICLE_POLL_STATS_BUCKETS; i++)
+      total.time_hist[i] += st.time_hist[i];
+    }
+  }
+
+
+/**
+ * PollerStatsMetrics: internal: update poller metrics from the statistics (called once per minute)
+ */
+void OvmsVehicle::PollerStatsMetrics()
+  {
+  OvmsRecMutexLock lock(&m_poll_mutex);
+  if (!m_poll_stats)
+    return;
+
+  poll_stats_t total;
+  PollerStatsTotal(total);
+  uint32_t now = PollerTime();
+  float seconds = (now - m_poll_stats_last_time) / 1000.0f;
+  if (seconds < 1)
+    seconds = 1;
+  uint32_t requests = total.requests - m_poll_stats_last.requests;
+  uint32_t responses = total.responses - m_poll_stats_last.responses;
+  uint32_t frames = total.frames - m_poll_stats_last.frames;
+
+  StdMetrics.ms_m_poll_rate->SetValue(TRUNCPREC(requests / seconds, 2));
+  StdMetrics.ms_m_poll_framerate->SetValue(TRUNCPREC((requests + frames) / seconds, 2));
+  StdMetrics.ms_m_poll_rtt->SetValue(responses ? (int)((total.time_sum - m_poll_stats_last.time_sum) / responses) : 0);
+  StdMetrics.ms_m_poll_timeouts->SetValue((int)(total.timeouts - m_poll_stats_last.timeouts));
+  StdMetrics.ms_m_poll_errors->SetValue((int)(total.errors - m_poll_stats_last.errors));
+
+  m_poll_stats_last = total;
+  m_poll_stats_last_time = now;
+  }
+
+
+/**
+ * PollerGetBus: internal: get bus for a poll entry
+ */
+canbus* OvmsVehicle::PollerGetBus(uint8_t pollbus)
+  {
+  switch (pollbus)
+    {
+    case 1:
+      return m_can1;
+    case 2:
+      return m_can2;
+    case 3:
+      return m_can3;
+    case 4:
+      return m_can4;
+    default:
+      return m_poll_bus_default;
+    }
+  }
+
+
+/**
+ * PollerSessionReset: internal: abandon all sessions
+ */
+void OvmsVehicle::PollerSessionReset()
+  {
+  for (int i = 0; i < VEHICLE_POLL_MAXSESSIONS; i++)
+    {
+    m_poll_session[i].entry = NULL;
+    m_poll_session[i].done = false;
+    m_poll_session[i].rxbuf.clear();
+    m_poll_session[i].stats = NULL;
+    }
+  m_poll_session_cnt = 0;
+  m_poll_session_cur = -1;
+  m_poll_session_rx = -1;
+  m_poll_sent_ahead.clear();
+  m_poll_cycle_done = false;
+  m_poll_wait = 0;
+  m_poll_txmsgid = 0;
+  }
+
+
+/**
+ * PollerSessionLoad: internal: load session state into the m_poll_… members
+ *  The response processing works on the members, which are also read by the
+ *  application's IncomingPoll…() handlers.
+ */
+void OvmsVehicle::PollerSessionLoad(int index)
+  {
+  poll_session_t &s = m_poll_session[index];
+  m_poll_bus = s.bus;
+  m_poll_protocol = s.protocol;
+  m_poll_moduleid_sent = s.moduleid_sent;
+  m_poll_moduleid_low = s.moduleid_low;
+  m_poll_moduleid_high = s.moduleid_high;
+  m_poll_type = s.type;
+  m_poll_pid = s.pid;
+  m_poll_ml_remain = s.ml_remain;
+  m_poll_ml_offset = s.ml_offset;
+  m_poll_ml_frame = s.ml_frame;
+  m_poll_wait = s.wait;
+  m_poll_txmsgid = s.txmsgid;
+  m_poll_session_cur = index;
+  }
+
+
+/**
+ * PollerSessionSave: internal: store the m_poll_… members into the session
+ *  Skipped if the session has been reset in the meantime (e.g. by PollSetPidList()).
+ */
+void OvmsVehicle::PollerSessionSave(int index)
+  {
+  if (m_poll_session_cur != index)
+    return;
+  poll_session_t &s = m_poll_session[index];
+  s.bus = m_poll_bus;
+  s.protocol = m_poll_protocol;
+  s.moduleid_sent = m_poll_moduleid_sent;
+  s.moduleid_low = m_poll_moduleid_low;
+  s.moduleid_high = m_poll_moduleid_high;
+  s.type = m_poll_type;
+  s.pid = m_poll_pid;
+  s.ml_remain = m_poll_ml_remain;
+  s.ml_offset = m_poll_ml_offset;
+  s.ml_frame = m_poll_ml_frame;
+  s.wait = m_poll_wait;
+  s.txmsgid = m_poll_txmsgid;
+  }
+
+
+/**
+ * PollerSessionClose: internal: free session
+ */
+void OvmsVehicle::PollerSessionClose(int index)
+  {
+  poll_session_t &s = m_poll_session[index];
+  if (!s.entry)
+    return;
+  s.entry = NULL;
+  s.done = false;
+  s.rxbuf.clear();
+  s.stats = NULL;
+  m_poll_session_cnt--;
+  if (m_poll_session_rx == index)
+    m_poll_session_rx = -1;
+  if (m_poll_session_cur == index)
+    m_poll_session_cur = -1;
+  }
+
+
+/**
+ * PollerSessionStart: internal: send request for a poll entry, if possible
+ *  A request can be sent if no other request to the same ECU is in flight,
+ *  and the session limits allow it. Broadcasts need the bus exclusively.
+ */
+bool OvmsVehicle::PollerSessionStart(const poll_pid_t* entry, bool fromTicker)
+  {
+  canbus* bus = PollerGetBus(entry->pollbus);
+  bool broadcast = (entry->rxmoduleid == 0);
+  int index = -1, onbus = 0;
+  uint32_t now = PollerTime();
+
+  if (!PollerBudgetAvailable(now))
+    return false;
+
+  for (int i = 0; i < VEHICLE_POLL_MAXSESSIONS; i++)
+    {
+    poll_session_t &s = m_poll_session[i];
+    if (!s.entry)
       {
-      // We need to poll this one...
-      m_poll_protocol = m_poll_plcur->protocol;
-      m_poll_type = m_poll_plcur->type;
-      m_poll_pid = m_poll_plcur->pid;
-      if (m_poll_plcur->rxmoduleid != 0)
+      if (index < 0) index = i;
+      continue;
+      }
+    if (s.bus != bus)
+      continue;
+    if (broadcast || s.entry->rxmoduleid == 0)
+      return false;
+    if (s.entry->rxmoduleid == entry->rxmoduleid && s.protocol == entry->protocol)
+      return false;
+    onbus++;
+    }
+  if (index < 0 || m_poll_session_cnt >= m_poll_session_max || onbus >= m_poll_session_busmax)
+    return false;
+
+  m_poll_bus = bus;
+  m_poll_protocol = entry->protocol;
+  m_poll_type = entry->type;
+  m_poll_pid = entry->pid;
+  if (entry->rxmoduleid != 0)
+    {
+    // send to <moduleid>, listen to response from <rmoduleid>:
+    m_poll_moduleid_sent = entry->txmoduleid;
+    m_poll_moduleid_low = entry->rxmoduleid;
+    m_poll_moduleid_high = entry->rxmoduleid;
+    }
+  else
+    {
+    // broadcast: send to 0x7df, listen to all responses:
+    m_poll_moduleid_sent = 0x7df;
+    m_poll_moduleid_low = 0x7e8;
+    m_poll_moduleid_high = 0x7ef;
+    }
+
+  ESP_LOGD(TAG, "PollerSend(%d): send [bus=%d, type=%02X, pid=%X], expecting %03x/%03x-%03x",
+           fromTicker, entry->pollbus, m_poll_type, m_poll_pid, m_poll_moduleid_sent,
+           m_poll_moduleid_low, m_poll_moduleid_high);
+
+  CAN_frame_t txframe;
+  uint8_t* txdata;
+  memset(&txframe,0,sizeof(txframe));
+  txframe.origin = m_poll_bus;
+  txframe.callback = &m_poll_txcallback;
+  txframe.FIR.B.FF = CAN_frame_std;
+  txframe.FIR.B.DLC = 8;
+
+  if (m_poll_protocol == ISOTP_EXTADR)
+    {
+    txframe.MsgID = m_poll_moduleid_sent >> 8;
+    txframe.data.u8[0] = m_poll_moduleid_sent & 0xff;
+    txdata = &txframe.data.u8[1];
+    }
+  else
+    {
+    txframe.MsgID = m_poll_moduleid_sent;
+    txdata = &txframe.data.u8[0];
+    }
+
+  if (POLL_TYPE_HAS_16BIT_PID(entry->type))
+    {
+    uint8_t datalen = LIMIT_MAX(entry->args.datalen, 4);
+    txdata[0] = (ISOTP_FT_SINGLE << 4) + 3 + datalen;
+    txdata[1] = m_poll_type;
+    txdata[2] = m_poll_pid >> 8;
+    txdata[3] = m_poll_pid & 0xff;
+    memcpy(&txdata[4], entry->args.data, datalen);
+    }
+  else if (POLL_TYPE_HAS_8BIT_PID(entry->type))
+    {
+    uint8_t datalen = LIMIT_MAX(entry->args.datalen, 5);
+    txdata[0] = (ISOTP_FT_SINGLE << 4) + 2 + datalen;
+    txdata[1] = m_poll_type;
+    txdata[2] = m_poll_pid;
+    memcpy(&txdata[3], entry->args.data, datalen);
+    }
+  else
+    {
+    uint8_t datalen = LIMIT_MAX(entry->args.datalen, 6);
+    txdata[0] = (ISOTP_FT_SINGLE << 4) + 1 + datalen;
+    txdata[1] = m_poll_type;
+    memcpy(&txdata[2], entry->args.data, datalen);
+    }
+
+  m_poll_txmsgid = txframe.MsgID;
+  m_poll_ml_frame = 0;
+  m_poll_ml_offset = 0;
+  m_poll_ml_remain = 0;
+  m_poll_wait = 2;
+
+  poll_session_t &s = m_poll_session[index];
+  s.entry = entry;
+  s.done = false;
+  s.rxbuf.clear();
+  s.sent = now;
+  s.stats = NULL;
+  if (m_poll_stats)
+    {
+    s.stats = &(*m_poll_stats)[(uint64_t)m_poll_moduleid_sent << 32 | (uint32_t)m_poll_type << 16 | m_poll_pid];
+    s.stats->requests++;
+    }
+  m_poll_session_cnt++;
+  m_poll_session_cur = index;
+  PollerSessionSave(index);
+
+  if (m_poll_budget)
+    {
+    if ((int32_t)(m_poll_budget_tat - now) < 0)
+      m_poll_budget_tat = now;
+    m_poll_budget_tat += 1000 / m_poll_budget;
+    }
+
+  m_poll_bus->Write(&txframe);
+  return true;
+  }
+
+
+/**
+ * PollerBudgetAvailable: internal: check request rate budget
+ */
+bool OvmsVehicle::PollerBudgetAvailable(uint32_t now)
+  {
+  return (m_poll_budget == 0 || (int32_t)(m_poll_budget_tat - now) < 1000);
+  }
+
+
+/**
+ * PollerResetDue: internal: reset the due times of POLL_MS entries (all due now)
+ */
+void OvmsVehicle::PollerResetDue()
+  {
+  uint32_t now = PollerTime();
+  size_t count = 0;
+  if (m_poll_plist)
+    {
+    for (const poll_pid_t* entry = m_poll_plist; entry->txmoduleid != 0; entry++)
+      count++;
+    }
+  m_poll_due.assign(count, now);
+  m_poll_due_next = now;
+  m_poll_due_valid = (count > 0);
+  }
+
+
+/**
+ * PollerSendFast: internal: send due POLL_MS entries, determine next due time
+ *  POLL_MS entries are scheduled by their individual due times. An entry blocked
+ *  by a busy ECU is retried on the next response completion.
+ */
+void OvmsVehicle::PollerSendFast(bool fromTicker)
+  {
+  uint32_t now = PollerTime();
+  uint32_t next = 0;
+  bool next_valid = false;
+  size_t index = 0;
+
+  for (const poll_pid_t* entry = m_poll_plist; entry->txmoduleid != 0 && index < m_poll_due.size(); entry++, index++)
+    {
+    uint16_t polltime = entry->polltime[m_poll_state];
+    uint32_t interval = polltime & ~VEHICLE_POLL_MS;
+    if ((polltime & VEHICLE_POLL_MS) == 0 || interval == 0)
+      continue;
+
+    uint32_t due = m_poll_due[index];
+    if ((int32_t)(due - now) <= 0)
+      {
+      if (!PollerBudgetAvailable(now))
         {
-        // send to <moduleid>, listen to response from <rmoduleid>:
-        m_poll_moduleid_sent = m_poll_plcur->txmoduleid;
-        m_poll_moduleid_low = m_poll_plcur->rxmoduleid;
-        m_poll_moduleid_high = m_poll_plcur->rxmoduleid;
+        // retry when the budget allows:
+        due = m_poll_budget_tat - 999;
         }
-      else
+      else if (PollerSessionStart(entry, fromTicker))
         {
-        // broadcast: send to 0x7df, listen to all responses:
-        m_poll_moduleid_sent = 0x7df;
-        m_poll_moduleid_low = 0x7e8;
-        m_poll_moduleid_high = 0x7ef;
+        m_poll_fast_sent = true;
+        due += interval;
+        if ((int32_t)(due - now) <= 0)
+          due = now + interval; // skip missed intervals
+        m_poll_due[index] = due;
         }
-
-      switch (m_poll_plcur->pollbus)
+      else
         {
-        case 1:
-          m_poll_bus = m_can1;
-          break;
-        case 2:
-          m_poll_bus = m_can2;
-          break;
-        case 3:
-          m_poll_bus = m_can3;
-          break;
-        case 4:
-          m_poll_bus = m_can4;
-          break;
-        default:
-          m_poll_bus = m_poll_bus_default;
+        // ECU/bus busy, retry on response:
+        continue;
         }
+      }
 
-      ESP_LOGD(TAG, "PollerSend(%d): send [bus=%d, type=%02X, pid=%X], expecting %03x/%03x-%03x",
-               fromTicker, m_poll_plcur->pollbus, m_poll_type, m_poll_pid, m_poll_moduleid_sent,
-               m_poll_moduleid_low, m_poll_moduleid_high);
+    if (!next_valid || (int32_t)(due - next) < 0)
+      {
+      next = due;
+      next_valid = true;
+      }
+    }
 
-      CAN_frame_t txframe;
-      uint8_t* txdata;
-      memset(&txframe,0,sizeof(txframe));
-      txframe.origin = m_poll_bus;
-      txframe.callback = &m_poll_txcallback;
-      txframe.FIR.B.FF = CAN_frame_std;
-      txframe.FIR.B.DLC = 8;
+  m_poll_due_next = next;
+  m_poll_due_valid = next_valid;
+  }
 
-      if (m_poll_protocol == ISOTP_EXTADR)
+
+/**
+ * PollerWaitTime: internal: get max RxTask wait time until next POLL_MS entry is due
+ */
+TickType_t OvmsVehicle::PollerWaitTime()
+  {
+  if (!m_poll_due_valid)
+    return portMAX_DELAY;
+  int32_t ms = m_poll_due_next - PollerTime();
+  if (ms <= 0)
+    return 0;
+  return (ms + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS;
+  }
+
+
+/**
+ * PollerSendDue: internal: send POLL_MS entries if due (called by RxTask)
+ */
+void OvmsVehicle::PollerSendDue()
+  {
+  if (m_poll_due_valid && (int32_t)(PollerTime() - m_poll_due_next) >= 0)
+    PollerSend(false);
+  }
+
+
+/**
+ * PollerSend: internal: start next due request(s)
+ */
+void OvmsVehicle::PollerSend(bool fromTicker)
+  {
+  OvmsRecMutexLock lock(&m_poll_mutex);
+
+  if (fromTicker)
+    {
+    // Timer ticker call: reset throttling counter, check response timeouts
+    m_poll_sequence_cnt = 0;
+    m_poll_cycle_done = false;
+    for (int i = 0; i < VEHICLE_POLL_MAXSESSIONS; i++)
+      {
+      poll_session_t &s = m_poll_session[i];
+      if (s.entry && !s.done && s.wait > 0 && --s.wait == 0)
         {
-        txframe.MsgID = m_poll_moduleid_sent >> 8;
-        txframe.data.u8[0] = m_poll_moduleid_sent & 0xff;
-        txdata = &txframe.data.u8[1];
+        if (s.stats) s.stats->timeouts++;
+        PollerSessionClose(i);
         }
-      else
+      }
+    PollerFlush();
+    }
+
+  // Don't do anything with no bus, no list or an empty list
+  if (!m_poll_bus_default || !m_poll_plist || m_poll_plist->txmoduleid == 0) return;
+
+  if (m_poll_plcur == NULL) m_poll_plcur = m_poll_plist;
+
+  if (m_poll_due.empty())
+    {
+    PollerSendList(fromTicker);
+    }
+  else if (m_poll_fast_sent)
+    {
+    // POLL_MS entries and list cycle take turns in precedence:
+    PollerSendList(fromTicker);
+    PollerSendFast(fromTicker);
+    }
+  else
+    {
+    PollerSendFast(fromTicker);
+    PollerSendList(fromTicker);
+    }
+  }
+
+
+/**
+ * PollerSendList: internal: start next due request(s) of the current list cycle
+ */
+void OvmsVehicle::PollerSendList(bool fromTicker)
+  {
+  // Next list cycle starts with the next ticker:
+  if (m_poll_cycle_done)
+    return;
+
+  // ESP_LOGD(TAG, "PollerSend(%d): entry at[type=%02X, pid=%X], ticker=%u, sessions=%u, cnt=%u/%u",
+  //          fromTicker, m_poll_plcur->type, m_poll_plcur->pid,
+  //          m_poll_ticker, m_poll_session_cnt, m_poll_sequence_cnt, m_poll_sequence_max);
+
+  while (m_poll_plcur->txmoduleid != 0)
+    {
+    if ((m_poll_plcur->polltime[m_poll_state] > 0) &&
+        ((m_poll_plcur->polltime[m_poll_state] & VEHICLE_POLL_MS) == 0) &&
+        ((m_poll_ticker % m_poll_plcur->polltime[m_poll_state]) == 0))
+      {
+      // We need to poll this one...
+      auto ahead = std::find(m_poll_sent_ahead.begin(), m_poll_sent_ahead.end(), m_poll_plcur);
+      if (ahead != m_poll_sent_ahead.end())
         {
-        txframe.MsgID = m_poll_moduleid_sent;
-        txdata = &txframe.data.u8[0];
+        // …already done out of list order:
+        m_poll_sent_ahead.erase(ahead);
         }
-
-      if (POLL_TYPE_HAS_16BIT_PID(m_poll_plcur->type))
+      else if (m_poll_sequence_max && m_poll_sequence_cnt >= m_poll_sequence_max)
         {
-        uint8_t datalen = LIMIT_MAX(m_poll_plcur->args.datalen, 4);
-        txdata[0] = (ISOTP_FT_SINGLE << 4) + 3 + datalen;
-        txdata[1] = m_poll_type;
-        txdata[2] = m_poll_pid >> 8;
-        txdata[3] = m_poll_pid & 0xff;
-        memcpy(&txdata[4], m_poll_plcur->args.data, datalen);
+        // …but throttling limit reached:
+        return;
         }
-      else if (POLL_TYPE_HAS_8BIT_PID(m_poll_plcur->type))
+      else if (PollerSessionStart(m_poll_plcur, fromTicker))
         {
-        uint8_t datalen = LIMIT_MAX(m_poll_plcur->args.datalen, 5);
-        txdata[0] = (ISOTP_FT_SINGLE << 4) + 2 + datalen;
-        txdata[1] = m_poll_type;
-        txdata[2] = m_poll_pid;
-        memcpy(&txdata[3], m_poll_plcur->args.data, datalen);
+        m_poll_sequence_cnt++;
+        m_poll_fast_sent = false;
         }
       else
         {
-        uint8_t datalen = LIMIT_MAX(m_poll_plcur->args.datalen, 6);
-        txdata[0] = (ISOTP_FT_SINGLE << 4) + 1 + datalen;
-        txdata[1] = m_poll_type;
-        memcpy(&txdata[2], m_poll_plcur->args.data, datalen);
+        // …but the ECU or bus is busy. With concurrency enabled, check
+        // if we can send later entries to other ECUs in the meantime:
+        if (m_poll_session_max > 1)
+          {
+          for (const poll_pid_t* entry = m_poll_plcur+1; entry->txmoduleid != 0; entry++)
+            {
+            if (m_poll_session_cnt >= m_poll_session_max ||
+                (m_poll_sequence_max && m_poll_sequence_cnt >= m_poll_sequence_max))
+              break;
+            if ((entry->polltime[m_poll_state] > 0) &&
+                ((entry->polltime[m_poll_state] & VEHICLE_POLL_MS) == 0) &&
+                ((m_poll_ticker % entry->polltime[m_poll_state]) == 0) &&
+                std::find(m_poll_sent_ahead.begin(), m_poll_sent_ahead.end(), entry) == m_poll_sent_ahead.end() &&
+                PollerSessionStart(entry, fromTicker))
+              {
+              m_poll_sent_ahead.push_back(entry);
+              m_poll_sequence_cnt++;
+              m_poll_fast_sent = false;
+              }
+            }
+          }
+        return;
         }
-
-      m_poll_txmsgid = txframe.MsgID;
-      m_poll_ml_frame = 0;
-      m_poll_ml_offset = 0;
-      m_poll_ml_remain = 0;
-      m_poll_wait = 2;
-      m_poll_plcur++;
-      m_poll_sequence_cnt++;
-      m_poll_bus->Write(&txframe);
-
-      return;
       }
 
-    // Poll entry is not due, check next
+    // Poll entry done or not due, check next
     m_poll_plcur++;
     }
 
-  // Completed checking all poll entries for the current m_poll_ticker
+  // All poll entries for the current m_poll_ticker have been sent,
+  // the cycle is complete when all their responses are in (or timed out):
+  for (int i = 0; i < VEHICLE_POLL_MAXSESSIONS; i++)
+    {
+    if (m_poll_session[i].entry && (m_poll_session[i].entry->polltime[m_poll_state] & VEHICLE_POLL_MS) == 0)
+      return;
+    }
+
   // ESP_LOGD(TAG, "PollerSend(%d): cycle complete for ticker=%u", fromTicker, m_poll_ticker);
   m_poll_plcur = m_poll_plist;
+  m_poll_sent_ahead.clear();
+  m_poll_cycle_done = true;
   m_poll_ticker++;
   if (m_poll_ticker > 3600) m_poll_ticker -= 3600;
   }
@@ -374,14 +979,27 @@ void OvmsVehicle::PollerTxCallback(const CAN_frame_t* frame, bool success)
   {
   OvmsRecMutexLock lock(&m_poll_mutex);
 
-  // Check for a late callback:
-  if (!m_poll_wait || !m_poll_plist || frame->origin != m_poll_bus || frame->MsgID != m_poll_txmsgid)
+  if (!m_poll_plist)
+    return;
+
+  // Find the session, ignore late callbacks:
+  int index;
+  for (index = 0; index < VEHICLE_POLL_MAXSESSIONS; index++)
+    {
+    poll_session_t &s = m_poll_session[index];
+    if (s.entry && !s.done && s.wait && frame->origin == s.bus && frame->MsgID == s.txmsgid &&
+        (s.protocol != ISOTP_EXTADR || frame->data.u8[0] == (s.moduleid_sent & 0xff)))
+      break;
+    }
+  if (index == VEHICLE_POLL_MAXSESSIONS)
     return;
+  PollerSessionLoad(index);
 
   // On failure, try to speed up the current poll timeout:
   if (!success)
     {
     m_poll_wait = 0;
+    if (m_poll_session[index].stats) m_poll_session[index].stats->txfails++;
     if (m_poll_single_rxbuf)
       {
       m_poll_single_rxerr = POLLSINGLE_TXFAILURE;
@@ -392,11 +1010,191 @@ void OvmsVehicle::PollerTxCallback(const CAN_frame_t* frame, bool success)
 
   // Forward to application:
   IncomingPollTxCallback(m_poll_bus, m_poll_moduleid_sent, m_poll_type, m_poll_pid, success);
+
+  PollerSessionSave(index);
+  if (m_poll_session_cur == index && m_poll_wait == 0)
+    {
+    PollerSessionClose(index);
+    PollerFlush();
+    }
+  }
+
+
+/**
+ * PollerDeliver: internal: forward response frame of the current session to the application
+ *  Only one response is delivered at a time, frames of other sessions are queued
+ *  until the response currently being delivered is complete.
+ */
+void OvmsVehicle::PollerDeliver(canbus* bus, uint8_t* data, uint8_t length)
+  {
+  int index = m_poll_session_cur;
+  if (m_poll_session_rx < 0 || m_poll_session_rx == index)
+    {
+    m_poll_session_rx = (m_poll_ml_remain > 0) ? index : -1;
+    IncomingPollReply(bus, m_poll_type, m_poll_pid, data, length, m_poll_ml_remain);
+    }
+  else
+    {
+    std::string &rxbuf = m_poll_session[index].rxbuf;
+    rxbuf.append(1, (char) length);
+    rxbuf.append(1, (char) (m_poll_ml_remain & 0xff));
+    rxbuf.append(1, (char) (m_poll_ml_remain >> 8));
+    rxbuf.append((char*) data, length);
+    }
   }
 
 
 /**
- * PollerSend: internal: process poll response frame
+ * PollerDeliverError: internal: forward error response of the current session to the application
+ *  Errors are queued along with response frames (see PollerDeliver()), so the application
+ *  sees them in the context of the request they belong to. Queued errors are marked by
+ *  the length byte POLLER_RXBUF_ERROR, followed by the error code.
+ */
+void OvmsVehicle::PollerDeliverError(canbus* bus, uint16_t code)
+  {
+  int index = m_poll_session_cur;
+  if (m_poll_session_rx < 0 || m_poll_session_rx == index)
+    {
+    m_poll_session_rx = -1;
+    IncomingPollError(bus, m_poll_type, m_poll_pid, code);
+    }
+  else
+    {
+    std::string &rxbuf = m_poll_session[index].rxbuf;
+    rxbuf.append(1, (char) POLLER_RXBUF_ERROR);
+    rxbuf.append(1, (char) (code & 0xff));
+    rxbuf.append(1, (char) (code >> 8));
+    }
+  }
+
+
+/**
+ * PollerFlush: internal: deliver queued response frames
+ *  Replays the queued frames of the next session, which becomes the delivering
+ *  session if its response is not yet complete.
+ */
+void OvmsVehicle::PollerFlush()
+  {
+  for (int i = 0; i < VEHICLE_POLL_MAXSESSIONS && m_poll_session_rx < 0; i++)
+    {
+    poll_session_t &s = m_poll_session[i];
+    if (!s.entry || s.rxbuf.empty())
+      continue;
+
+    std::string rxbuf;
+    rxbuf.swap(s.rxbuf);
+    PollerSessionLoad(i);
+    m_poll_ml_frame = 0;
+    m_poll_ml_offset = 0;
+    for (size_t pos = 0; pos + 3 <= rxbuf.size(); )
+      {
+      uint8_t length = rxbuf[pos];
+      uint8_t* data = (uint8_t*) &rxbuf[pos+3];
+      uint16_t value = (uint8_t)rxbuf[pos+1] | ((uint8_t)rxbuf[pos+2] << 8);
+      if (length == POLLER_RXBUF_ERROR)
+        {
+        // Queued error response:
+        pos += 3;
+        m_poll_ml_remain = 0;
+        IncomingPollError(m_poll_bus, m_poll_type, m_poll_pid, value);
+        if (m_poll_session_cur != i)
+          return; // poller has been reset by the application
+        continue;
+        }
+      m_poll_ml_remain = value;
+      pos += 3 + length;
+      IncomingPollReply(m_poll_bus, m_poll_type, m_poll_pid, data, length, m_poll_ml_remain);
+      if (m_poll_session_cur != i)
+        return; // poller has been reset by the application
+      m_poll_ml_frame++;
+      m_poll_ml_offset += length;
+      }
+
+    if (s.done)
+      {
+      PollerSessionClose(i);
+      }
+    else
+      {
+      // Continue delivering frames directly:
+      PollerSessionLoad(i);
+      m_poll_session_rx = i;
+      }
+    }
+  }
+
+
+/**
+ * PollerReceive: internal: find session for a received frame & process it
+ */
+static inline bool PollerSessionMatch(const OvmsVehicle::poll_session_t &s, const CAN_frame_t* frame, uint32_t &msgid)
+  {
+  if (!s.entry || s.done || !s.wait || frame->origin != s.bus)
+    return false;
+  if (s.protocol == ISOTP_EXTADR)
+    msgid = frame->MsgID << 8 | frame->data.u8[0];
+  else
+    msgid = frame->MsgID;
+  return (msgid >= s.moduleid_low && msgid <= s.moduleid_high);
+  }
+
+void OvmsVehicle::PollerReceive(CAN_frame_t* frame)
+  {
+  uint32_t msgid;
+  int index;
+
+  // This is a quick filter check to see if the frame is possibly intended for our poller.
+  // The filter will be checked again after locking the mutex.
+  for (index = 0; index < VEHICLE_POLL_MAXSESSIONS; index++)
+    {
+    if (PollerSessionMatch(m_poll_session[index], frame, msgid))
+      break;
+    }
+  if (index == VEHICLE_POLL_MAXSESSIONS)
+    return;
+
+  OvmsRecMutexLock lock(&m_poll_mutex);
+
+  for (index = 0; index < VEHICLE_POLL_MAXSESSIONS; index++)
+    {
+    if (PollerSessionMatch(m_poll_session[index], frame, msgid))
+      break;
+    }
+  if (index == VEHICLE_POLL_MAXSESSIONS || !m_poll_plist)
+    {
+    ESP_LOGD(TAG, "PollerReceive[%03X]: dropping expired poll response", frame->MsgID);
+    return;
+    }
+
+  PollerSessionLoad(index);
+  PollerReceive(frame, msgid);
+  PollerSessionSave(index);
+  if (m_poll_session_cur != index)
+    return; // poller has been reset by the application
+
+  if (m_poll_wait == 0)
+    {
+    // Request response complete:
+    bool broadcast = (m_poll_moduleid_sent == 0x7df);
+    if (m_poll_session[index].rxbuf.empty())
+      PollerSessionClose(index);
+    else
+      m_poll_session[index].done = true;
+    PollerFlush();
+
+    // Immediately send the next due poll if the poll was no broadcast
+    // (with potential further responses from other devices).
+    // PollerSend() applies the throttling & budget limits.
+    if (!broadcast)
+      {
+      PollerSend(false);
+      }
+    }
+  }
+
+
+/**
+ * PollerReceive: internal: process poll response frame for the session loaded
  */
 void OvmsVehicle::PollerReceive(CAN_frame_t* frame, uint32_t msgid)
   {
@@ -539,6 +1337,8 @@ void OvmsVehicle::PollerReceive(CAN_frame_t* frame, uint32_t msgid)
   // Process OBD/UDS payload
   // 
 
+  poll_stats_t* stats = (m_poll_session_cur >= 0) ? m_poll_session[m_poll_session_cur].stats : NULL;
+
   if (response_type == UDS_RESP_TYPE_NRC && error_type == m_poll_type)
     {
     // Negative Response Code:
@@ -556,6 +1356,11 @@ void OvmsVehicle::PollerReceive(CAN_frame_t* frame, uint32_t msgid)
       // Error: forward to application:
       ESP_LOGD(TAG, "PollerReceive[%03X]: process OBD/UDS error %02X(%X) code=%02X",
                msgid, m_poll_type, m_poll_pid, error_code);
+      if (stats)
+        {
+        stats->errors++;
+        stats->last_nrc = error_code;
+        }
       // Running single poll?
       if (m_poll_single_rxbuf)
         {
@@ -565,7 +1370,7 @@ void OvmsVehicle::PollerReceive(CAN_frame_t* frame, uint32_t msgid)
         }
       else
         {
-        IncomingPollError(frame->origin, m_poll_type, m_poll_pid, error_code);
+        PollerDeliverError(frame->origin, error_code);
         }
       // abort:
       m_poll_ml_remain = 0;
@@ -578,6 +1383,11 @@ void OvmsVehicle::PollerReceive(CAN_frame_t* frame, uint32_t msgid)
     ESP_LOGD(TAG, "PollerReceive[%03X]: process OBD/UDS response %02X(%X) frm=%u len=%u off=%u rem=%u",
              msgid, m_poll_type, m_poll_pid,
              m_poll_ml_frame, response_datalen, m_poll_ml_offset, m_poll_ml_remain);
+    if (stats)
+      {
+      stats->frames++;
+      stats->bytes += response_datalen;
+      }
     // Running single poll?
     if (m_poll_single_rxbuf)
       {
@@ -596,7 +1406,7 @@ void OvmsVehicle::PollerReceive(CAN_frame_t* frame, uint32_t msgid)
       }
     else
       {
-      IncomingPollReply(frame->origin, m_poll_type, m_poll_pid, response_data, response_datalen, m_poll_ml_remain);
+      PollerDeliver(frame->origin, response_data, response_datalen);
       }
     }
   else
@@ -666,18 +1476,8 @@ void OvmsVehicle::PollerReceive(CAN_frame_t* frame, uint32_t msgid)
     {
     // Request response complete:
     m_poll_wait = 0;
-    }
-
-
-  // Immediately send the next poll for this tick if…
-  // - we are not waiting for another frame
-  // - the poll was no broadcast (with potential further responses from other devices)
-  // - poll throttling is unlimited or limit isn't reached yet
-  if (m_poll_wait == 0 &&
-      m_poll_moduleid_sent != 0x7df &&
-      (!m_poll_sequence_max || m_poll_sequence_cnt < m_poll_sequence_max))
-    {
-    PollerSend(false);
+    if (stats)
+      PollerStatsAddTime(stats, PollerTime() - m_poll_session[m_poll_session_cur].sent);
     }
   }
 
@@ -95,6 +95,31 @@ void OvmsVehicleFactory::vehicle_status(int verbosity, OvmsWriter* writer, OvmsC
     }
   }
 
+void OvmsVehicleFactory::vehicle_poll_stats(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv)
+  {
+  if (MyVehicleFactory.m_currentvehicle != NULL)
+    {
+    MyVehicleFactory.m_currentvehicle->PollStatsOutput(verbosity, writer);
+    }
+  else
+    {
+    writer->puts("No vehicle module selected");
+    }
+  }
+
+void OvmsVehicleFactory::vehicle_poll_stats_reset(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv)
+  {
+  if (MyVehicleFactory.m_currentvehicle != NULL)
+    {
+    MyVehicleFactory.m_currentvehicle->PollStatsReset();
+    writer->puts("Poller statistics have been reset.");
+    }
+  else
+    {
+    writer->puts("No vehicle module selected");
+    }
+  }
+
 void OvmsVehicleFactory::vehicle_wakeup(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv)
   {
   if (MyVehicleFactory.m_currentvehicle==NULL)
@@ -62,6 +62,12 @@ MetricsStandard::MetricsStandard()
   ms_m_egpio_monitor = new OvmsMetricBitset<10,0>(MS_M_EGPIO_MONITOR, SM_STALE_MAX);
 #endif //CONFIG_OVMS_COMP_MAX7317
 
+  ms_m_poll_rate = new OvmsMetricFloat(MS_M_POLL_RATE, SM_STALE_MID);
+  ms_m_poll_framerate = new OvmsMetricFloat(MS_M_POLL_FRAMERATE, SM_STALE_MID);
+  ms_m_poll_rtt = new OvmsMetricInt(MS_M_POLL_RTT, SM_STALE_MID);
+  ms_m_poll_timeouts = new OvmsMetricInt(MS_M_POLL_TIMEOUTS, SM_STALE_MID);
+  ms_m_poll_errors = new OvmsMetricInt(MS_M_POLL_ERRORS, SM_STALE_MID);
+
   ms_s_v2_connected = new OvmsMetricBool(MS_S_V2_CONNECTED);
   ms_s_v2_peers = new OvmsMetricInt(MS_S_V2_PEERS);
 
@@ -65,6 +65,12 @@
 #define MS_M_EGPIO_OUTPUT           "m.egpio.output"
 #endif //CONFIG_OVMS_COMP_MAX7317
 
+#define MS_M_POLL_RATE              "m.poll.rate"
+#define MS_M_POLL_FRAMERATE         "m.poll.framerate"
+#define MS_M_POLL_RTT               "m.poll.rtt"
+#define MS_M_POLL_TIMEOUTS          "m.poll.timeouts"
+#define MS_M_POLL_ERRORS            "m.poll.errors"
+
 #define MS_S_V2_CONNECTED           "s.v2.connected"
 #define MS_S_V2_PEERS               "s.v2.peers"
 
@@ -295,6 +301,12 @@ class MetricsStandard
     OvmsMetricBitset<10,0>* ms_m_egpio_monitor;           // EGPIO (MAX7317) input monitoring state
 #endif //CONFIG_OVMS_COMP_MAX7317
 
+    OvmsMetricFloat*  ms_m_poll_rate;                     // Poller requests per second (last minute, see "vehicle poll stats")
+    OvmsMetricFloat*  ms_m_poll_framerate;                // Poller request & response frames per second (last minute)
+    OvmsMetricInt*    ms_m_poll_rtt;                      // Poller average response time (last minute) [ms]
+    OvmsMetricInt*    ms_m_poll_timeouts;                 // Poller request timeouts (last minute)
+    OvmsMetricInt*    ms_m_poll_errors;                   // Poller NRC responses (last minute)
+
     OvmsMetricBool*   ms_s_v2_connected;                  // True = V2 server connected [1]
     OvmsMetricInt*    ms_s_v2_peers;                      // V2 clients connected [1]
 
@@ -347,7 +347,8 @@ void Boot::Restart(bool hard)
   #undef bind  // Kludgy, but works
   using std::placeholders::_1;
   using std::placeholders::_2;
-  MyEvents.RegisterEvent(TAG,"ticker.1", std::bind(&Boot::Ticker1, this, _1, _2));
+  using std::placeholders::_3;
+  MyEvents.RegisterEventId(TAG,"ticker.1", std::bind(&Boot::Ticker1, this, _1, _2, _3));
   }
 
 void Boot::RestartPending(const char* tag)
@@ -364,7 +365,7 @@ void Boot::RestartReady(const char* tag)
     m_restart_timer = 2;
   }
 
-void Boot::Ticker1(std::string event, void* data)
+void Boot::Ticker1(event_id_t id, const char* event, void* data)
   {
   if (m_restart_timer > 0)
     {
@@ -420,9 +421,9 @@ void Boot::ErrorCallback(XtExcFrame *frame, int core_id, bool is_abort)
     boot_data.crash_data.bt[i++].pc = 0;
 
   // Save Event debug info:
-  if (!MyEvents.m_current_event.empty())
+  if (MyEvents.m_current_event)
     {
-    strlcpy(boot_data.curr_event_name, MyEvents.m_current_event.c_str(), sizeof(boot_data.curr_event_name));
+    strlcpy(boot_data.curr_event_name, MyEvents.m_current_event, sizeof(boot_data.curr_event_name));
     if (MyEvents.m_current_callback)
       strlcpy(boot_data.curr_event_handler, MyEvents.m_current_callback->m_caller.c_str(), sizeof(boot_data.curr_event_handler));
     else
@@ -36,6 +36,7 @@ static const char *TAG = "command";
 #include <string.h>
 #include <ctype.h>
 #include <functional>
+#include <algorithm>
 #include <esp_log.h>
 #include <sys/time.h>
 #include <sys/types.h>
@@ -50,6 +51,8 @@ static const char *TAG = "command";
 #include "buffered_shell.h"
 #include "log_buffers.h"
 #include "ovms_semaphore.h"
+#include "ovms_malloc.h"
+#include "esp_timer.h"
 #ifdef CONFIG_OVMS_SC_JAVASCRIPT_DUKTAPE
 #include "duktape.h"
 #endif // #ifdef CONFIG_OVMS_SC_JAVASCRIPT_DUKTAPE
@@ -797,9 +800,17 @@ OvmsCommandApp::OvmsCommandApp()
   m_logfile_size = 0;
   m_logfile_maxsize = 0;
   m_logtask = NULL;
-  m_logtask_queue = NULL;
+  m_logtask_exitack = NULL;
+  m_logbuf = NULL;
+  m_logbuf_size = 0;
+  m_logbuf_head = 0;
+  m_logbuf_tail = 0;
   m_logtask_dropcnt = 0;
   m_logfile_cyclecnt = 0;
+  m_logtask_linecnt = 0;
+  m_logtask_blockcnt = 0;
+  m_logtask_synccnt = 0;
+  m_logtask_fsynctime = 0;
   m_expiretask = 0;
 
   m_root.RegisterCommand("help", "Ask for help", help, "", 0, 0, false);
@@ -1015,21 +1026,16 @@ void OvmsCommandApp::Execute(int verbosity, OvmsWriter* writer, int argc, const
 
 /**
  * LogTask: file logging task
+ *  Log messages are copied into the ring buffer m_logbuf by Log(LogBuffers*), the
+ *  task collects them into blocks of LOGTASK_BLOCKSIZE bytes, aligned to the file
+ *  position, and writes a block when it's full or no more messages arrive within
+ *  LOGTASK_FLUSHDELAY ms.
  */
 
-struct LogTaskCmd
-  {
-  enum
-    {
-    LTC_Log,          // write data.logbuffers to file
-    LTC_Exit,         // close file, give data.cmdack, exit
-    } type;
-  union
-    {
-    LogBuffers*       logbuffers;
-    OvmsSemaphore*    cmdack;
-    } data;
-  };
+#define LOGTASK_BLOCKSIZE       4096    // file write block size [bytes]
+#define LOGTASK_FLUSHDELAY      100     // max delay for writing incomplete blocks [ms]
+#define LOGTASK_SYNCLOAD        10      // max fsync load: sync interval >= n * fsync time
+#define LOGTASK_SYNCMAXDELAY    10      // max sync delay while busy: n * idle sync period
 
 static void LogTaskEntry(void* me)
   {
@@ -1038,155 +1044,244 @@ static void LogTaskEntry(void* me)
 
 void OvmsCommandApp::LogTask()
   {
-  LogTaskCmd cmd;
   char tb[64];
+  time_t tb_sec = -1;
+  size_t tb_datelen = 0, tb_zonelen = 0;
+  std::string le;
+  le.reserve(256);
+
+  char* block = (char*) ExternalRamMalloc(LOGTASK_BLOCKSIZE);
+  size_t blocklen = 0;
+  size_t blocksize = LOGTASK_BLOCKSIZE - (m_logfile_size % LOGTASK_BLOCKSIZE);
+  bool failed = (block == NULL);
 
   m_logtask_linecnt = 0;
+  m_logtask_blockcnt = 0;
+  m_logtask_synccnt = 0;
   m_logtask_fsynctime = 0;
   m_logtask_laststamp = -11;
   m_logtask_basetime.tv_sec = 0;
   m_logtask_basetime.tv_usec = 0;
 
   // syncperiod: 0 = never, <0 = every n lines, >0 = after n/2 seconds idle
+  //  (while busy: after LOGTASK_SYNCMAXDELAY times that)
+  // The sync delay is raised if needed to keep the fsync time below 1/LOGTASK_SYNCLOAD.
   uint32_t linecnt_synced = 0;
   int syncperiod = MyConfig.GetParamValueInt("log", "file.syncperiod", 3);
-  TickType_t timeout = (syncperiod<=0) ? portMAX_DELAY : pdMS_TO_TICKS(syncperiod*500);
+  int64_t syncdelay = (int64_t) syncperiod * 500000;
+  int64_t lastsync = esp_timer_get_time();
 
-  for (;;)
+  // write block to file:
+  auto write_block = [&]() -> bool
     {
-    if (xQueueReceive(m_logtask_queue, (void*)&cmd, timeout) == pdTRUE)
+    if (blocklen == 0)
+      return true;
+    m_logfile_size += fwrite(block, 1, blocklen, m_logfile);
+    m_logtask_blockcnt++;
+    blocklen = 0;
+    // check file size:
+    if (m_logfile_maxsize && m_logfile_size > (m_logfile_maxsize*1024))
       {
-      // cmd received:
-      if (cmd.type == LogTaskCmd::LTC_Log)
-        {
-        // write logbuffers messages:
-        for (auto it = cmd.data.logbuffers->begin(); it != cmd.data.logbuffers->end(); it++)
-          {
-          std::string le = stripesc(*it);
-          if (*(le.data() + 1) == ' ' && *(le.data() + 2) == '(')
-            {
-            struct timeval stamp;
-            stamp.tv_sec = atoi(le.data() + 3);
-            stamp.tv_usec = (stamp.tv_sec % 1000) * 1000;
-            stamp.tv_sec /= 1000;
-            // If 10 seconds have elapsed since the previous log message or if a
-            // real base time hasn't been set yet, recalculate the correspondence
-            // of real time to system time.
-            if (stamp.tv_sec - m_logtask_laststamp > 10 || m_logtask_basetime.tv_sec < 1609459200)
-              {
-              struct timeval daytime, uptime;
-              gettimeofday(&daytime, NULL);
-              uptime.tv_sec = xTaskGetTickCount();
-              uptime.tv_usec = (uptime.tv_sec % 100) * 10000;
-              uptime.tv_sec /= 100;
-              daytime.tv_usec -= daytime.tv_usec % 10000;       // Always show 0 for ms units
-              timersub(&daytime, &uptime, &m_logtask_basetime);
-              }
-            m_logtask_laststamp = stamp.tv_sec;
-            // write timestamp:
-            timeradd(&m_logtask_basetime, &stamp, &stamp);
-            struct tm* tmu = localtime(&stamp.tv_sec);
-            strftime(tb, sizeof(tb), "%Y-%m-%d %H:%M:%S", tmu);
-            m_logfile_size += fwrite(tb, 1, strlen(tb), m_logfile);
-            snprintf(tb, sizeof(tb), ".%03lu ", stamp.tv_usec / 1000);
-            int len = strlen(tb);
-            strftime(tb+len, sizeof(tb)-len, "%Z ", tmu);
-            m_logfile_size += fwrite(tb, 1, strlen(tb), m_logfile);
-            }
-          // write log entry:
-          m_logfile_size += fwrite(le.data(), 1, le.size(), m_logfile);
-          m_logtask_linecnt++;
-          }
-        cmd.data.logbuffers->release();
+      if (!CycleLogfile())
+        return false;
+      }
+    // check file status:
+    if (ferror(m_logfile))
+      {
+      ESP_LOGE(TAG, "LogTask: writing to file failed, terminating");
+      return false;
+      }
+    blocksize = LOGTASK_BLOCKSIZE - (m_logfile_size % LOGTASK_BLOCKSIZE);
+    return true;
+    };
 
-        // check file size:
-        if (m_logfile_maxsize && m_logfile_size > (m_logfile_maxsize*1024))
-          {
-          if (!CycleLogfile())
-            break;
-          }
-        else if (syncperiod < 0 && m_logtask_linecnt >= linecnt_synced - syncperiod)
-          {
-          linecnt_synced = m_logtask_linecnt;
-          uint32_t t0 = esp_timer_get_time();
-          fflush(m_logfile);
-          fsync(fileno(m_logfile));
-          m_logtask_fsynctime += esp_timer_get_time() - t0;
-          }
+  // add data to block:
+  auto add_block = [&](const char* data, size_t len) -> bool
+    {
+    while (len)
+      {
+      size_t n = std::min(len, blocksize - blocklen);
+      memcpy(block + blocklen, data, n);
+      blocklen += n;
+      data += n;
+      len -= n;
+      if (blocklen == blocksize && !write_block())
+        return false;
+      }
+    return true;
+    };
 
-        // check file status:
-        if (ferror(m_logfile))
-          {
-          ESP_LOGE(TAG, "LogTask: writing to file failed, terminating");
-          break;
-          }
-        }
-      else if (cmd.type == LogTaskCmd::LTC_Exit)
-        {
+  // write block & sync file:
+  auto sync_file = [&]() -> bool
+    {
+    if (!write_block())
+      return false;
+    int64_t t0 = esp_timer_get_time();
+    fflush(m_logfile);
+    fsync(fileno(m_logfile));
+    lastsync = esp_timer_get_time();
+    uint32_t dt = lastsync - t0;
+    m_logtask_fsynctime += dt;
+    m_logtask_synccnt++;
+    linecnt_synced = m_logtask_linecnt;
+    if (syncperiod > 0)
+      syncdelay = std::max((int64_t) syncperiod * 500000, (int64_t) dt * LOGTASK_SYNCLOAD);
+    return true;
+    };
+
+  while (!failed)
+    {
+    uint32_t tail = m_logbuf_tail.load(std::memory_order_relaxed);
+    uint32_t head = m_logbuf_head.load(std::memory_order_acquire);
+
+    if (tail == head)
+      {
+      // idle:
+      if (m_logtask_exitack)
         break;
+      TickType_t timeout;
+      if (blocklen)
+        timeout = pdMS_TO_TICKS(LOGTASK_FLUSHDELAY);
+      else if (syncperiod > 0 && m_logtask_linecnt != linecnt_synced)
+        timeout = pdMS_TO_TICKS(syncdelay / 1000);
+      else
+        timeout = portMAX_DELAY;
+      if (ulTaskNotifyTake(pdTRUE, timeout) == 0)
+        {
+        // timeout: write incomplete block / sync file
+        if (blocklen)
+          failed = !write_block();
+        else
+          failed = !sync_file();
         }
+      continue;
       }
-    else
+
+    // process log entries:
+    while (tail != head && !failed)
       {
-      // cmd timeout: anything to sync?
-      if (m_logtask_linecnt != linecnt_synced)
+      // read entry, strip terminal escape sequences:
+      le.clear();
+      bool skip = false;
+      for (char c; (c = m_logbuf[tail++ & (m_logbuf_size-1)]) != 0; )
         {
-        linecnt_synced = m_logtask_linecnt;
-        uint32_t t0 = esp_timer_get_time();
-        fflush(m_logfile);
-        fsync(fileno(m_logfile));
-        m_logtask_fsynctime += esp_timer_get_time() - t0;
+        if (c == '\033' && m_logbuf[tail & (m_logbuf_size-1)] == '[')
+          skip = true;
+        else if (!skip)
+          le += c;
+        else if (c == 'm')
+          skip = false;
         }
+
+      if (le.size() > 3 && le[1] == ' ' && le[2] == '(')
+        {
+        struct timeval stamp;
+        stamp.tv_sec = atoi(le.data() + 3);
+        stamp.tv_usec = (stamp.tv_sec % 1000) * 1000;
+        stamp.tv_sec /= 1000;
+        // If 10 seconds have elapsed since the previous log message or if a
+        // real base time hasn't been set yet, recalculate the correspondence
+        // of real time to system time.
+        if (stamp.tv_sec - m_logtask_laststamp > 10 || m_logtask_basetime.tv_sec < 1609459200)
+          {
+          struct timeval daytime, uptime;
+          gettimeofday(&daytime, NULL);
+          uptime.tv_sec = xTaskGetTickCount();
+          uptime.tv_usec = (uptime.tv_sec % 100) * 10000;
+          uptime.tv_sec /= 100;
+          daytime.tv_usec -= daytime.tv_usec % 10000;       // Always show 0 for ms units
+          timersub(&daytime, &uptime, &m_logtask_basetime);
+          }
+        m_logtask_laststamp = stamp.tv_sec;
+        // write timestamp, date/time/zone formatting is cached per second:
+        timeradd(&m_logtask_basetime, &stamp, &stamp);
+        if (stamp.tv_sec != tb_sec)
+          {
+          tb_sec = stamp.tv_sec;
+          struct tm* tmu = localtime(&stamp.tv_sec);
+          tb_datelen = strftime(tb, 32, "%Y-%m-%d %H:%M:%S.", tmu);
+          tb_zonelen = strftime(tb+tb_datelen+4, sizeof(tb)-tb_datelen-4, "%Z ", tmu);
+          }
+        uint32_t ms = stamp.tv_usec / 1000;
+        tb[tb_datelen+0] = '0' + ms / 100;
+        tb[tb_datelen+1] = '0' + (ms / 10) % 10;
+        tb[tb_datelen+2] = '0' + ms % 10;
+        tb[tb_datelen+3] = ' ';
+        failed = !add_block(tb, tb_datelen + 4 + tb_zonelen);
+        }
+      // write log entry:
+      if (!failed)
+        failed = !add_block(le.data(), le.size());
+      m_logtask_linecnt++;
       }
+
+    m_logbuf_tail.store(tail, std::memory_order_release);
+    if (failed)
+      break;
+
+    // sync file:
+    if (syncperiod < 0 && m_logtask_linecnt >= linecnt_synced - syncperiod)
+      failed = !sync_file();
+    else if (syncperiod > 0 && m_logtask_linecnt != linecnt_synced &&
+             esp_timer_get_time() - lastsync > syncdelay * LOGTASK_SYNCMAXDELAY)
+      failed = !sync_file();
     }
 
   // cleanup & terminate:
   if (m_logfile)
-    fclose(m_logfile);
-  LogTaskCmd drop;
-  while (xQueueReceive(m_logtask_queue, (void*)&drop, 0) == pdTRUE)
     {
-    if (drop.type == LogTaskCmd::LTC_Log)
-      {
-      drop.data.logbuffers->release();
-      }
-    else if (drop.type == LogTaskCmd::LTC_Exit)
-      {
-      if (drop.data.cmdack)
-        drop.data.cmdack->Give();
-      }
+    if (!failed)
+      write_block();
+    fclose(m_logfile);
     }
-  vQueueDelete(m_logtask_queue);
+  if (block)
+    free(block);
   m_logfile = NULL;
-  m_logtask_queue = NULL;
-  m_logtask = NULL;
-  if (cmd.type == LogTaskCmd::LTC_Exit && cmd.data.cmdack)
-    cmd.data.cmdack->Give();
+  OvmsSemaphore* ack;
+    {
+    // fetch a pending exit request along with detaching, so StopLogTask()
+    // either sees the task gone or gets its ack:
+    OvmsMutexLock lock(&m_logbuf_mutex);
+    m_logbuf_tail.store(m_logbuf_head.load());
+    m_logtask = NULL;
+    ack = m_logtask_exitack;
+    m_logtask_exitack = NULL;
+    }
+  if (ack)
+    ack->Give();
   vTaskDelete(NULL);
   }
 
 bool OvmsCommandApp::StartLogTask(FILE* file)
   {
   OvmsMutexLock lock(&m_logtask_mutex);
+  setvbuf(file, NULL, _IONBF, 0);   // LogTask writes blocks
   m_logfile = file;
   if (m_logtask)
     return true;
-  // create queue:
-  m_logtask_dropcnt = 0;
-  m_logtask_queue = xQueueCreate(CONFIG_OVMS_LOGFILE_QUEUE_SIZE, sizeof(LogTaskCmd));
-  if (!m_logtask_queue)
-    {
-    ESP_LOGE(TAG, "StartLogTask: unable to create queue (out of memory)");
-    return false;
+  // create ring buffer (kept for later restarts, as log producers may still refer to it):
+  if (!m_logbuf)
+    {
+    m_logbuf_size = 1;
+    while (m_logbuf_size * 2 <= CONFIG_OVMS_LOGFILE_BUFFER_SIZE)
+      m_logbuf_size *= 2;
+    m_logbuf = (char*) ExternalRamMalloc(m_logbuf_size);
+    if (!m_logbuf)
+      {
+      ESP_LOGE(TAG, "StartLogTask: unable to create buffer (out of memory)");
+      return false;
+      }
     }
+  m_logtask_dropcnt = 0;
+  m_logtask_exitack = NULL;
+  m_logbuf_tail.store(m_logbuf_head.load());
   // create task:
   BaseType_t res = xTaskCreatePinnedToCore(LogTaskEntry, "OVMS FileLog", 3*1024, (void*)this,
     CONFIG_OVMS_LOGFILE_TASK_PRIORITY, &m_logtask, CORE(1));
   if (res != pdPASS)
     {
     ESP_LOGE(TAG, "StartLogTask: unable to create task, error code=%d", res);
-    vQueueDelete(m_logtask_queue);
-    m_logtask_queue = NULL;
+    m_logtask = NULL;
     return false;
     }
   // register as logging console:
@@ -1203,15 +1298,14 @@ bool OvmsCommandApp::StopLogTask()
   // detach from logging:
   SetMonitoring(false);
   MyCommandApp.DeregisterConsole(this);
-  // send exit command to task:
+  // send exit request to task…
   OvmsSemaphore ack;
-  LogTaskCmd cmd;
-  cmd.type = LogTaskCmd::LTC_Exit;
-  cmd.data.cmdack = &ack;
-  if (xQueueSend(m_logtask_queue, &cmd, (portTickType)portMAX_DELAY) != pdTRUE)
     {
-    ESP_LOGE(TAG, "StopLogTask: unable to send command to task");
-    return false;
+    OvmsMutexLock buflock(&m_logbuf_mutex);
+    if (!m_logtask)
+      return true;
+    m_logtask_exitack = &ack;
+    xTaskNotifyGive(m_logtask);
     }
   // …and wait for it to finish:
   ack.Take();
@@ -1323,20 +1417,36 @@ bool OvmsCommandApp::CycleLogfile()
 
 void OvmsCommandApp::Log(LogBuffers* msg)
   {
-  if (!m_logtask || !m_logtask_queue)
+  if (!m_logtask || !m_logbuf)
     {
     msg->release();
     return;
     }
-  // send to LogTask:
-  LogTaskCmd cmd;
-  cmd.type = LogTaskCmd::LTC_Log;
-  cmd.data.logbuffers = msg;
-  if (xQueueSend(m_logtask_queue, &cmd, 0) != pdTRUE)
+  // copy entries to LogTask ring buffer:
+  uint32_t len = 0;
+  for (auto it = msg->begin(); it != msg->end(); it++)
+    len += strlen(*it) + 1;
     {
-    m_logtask_dropcnt++;
-    msg->release();
+    OvmsMutexLock lock(&m_logbuf_mutex);
+    uint32_t head = m_logbuf_head.load(std::memory_order_relaxed);
+    if (!m_logtask || len > m_logbuf_size - (head - m_logbuf_tail.load(std::memory_order_acquire)))
+      {
+      m_logtask_dropcnt++;
+      }
+    else
+      {
+      for (auto it = msg->begin(); it != msg->end(); it++)
+        {
+        const char* s = *it;
+        do
+          m_logbuf[head++ & (m_logbuf_size-1)] = *s;
+        while (*s++);
+        }
+      m_logbuf_head.store(head, std::memory_order_release);
+      xTaskNotifyGive(m_logtask);
+      }
     }
+  msg->release();
   }
 
 void OvmsCommandApp::SetLoglevel(std::string tag, std::string level)
@@ -1464,6 +1574,9 @@ void OvmsCommandApp::ShowLogStatus(int verbosity, OvmsWriter* writer)
     "  Cycle count      : %u\n"
     "  Dropped messages : %u\n"
     "  Messages logged  : %u\n"
+    "  Blocks written   : %u\n"
+    "  Buffer usage     : %u of %u bytes\n"
+    "  Fsync count      : %u\n"
     "  Total fsync time : %.1f s\n"
     , m_consoles.size()
     , m_logfile ? "active" : "inactive"
@@ -1473,6 +1586,9 @@ void OvmsCommandApp::ShowLogStatus(int verbosity, OvmsWriter* writer)
     , m_logfile_cyclecnt
     , m_logtask_dropcnt
     , m_logtask_linecnt
+    , m_logtask_blockcnt
+    , m_logbuf_head.load() - m_logbuf_tail.load(), m_logbuf_size
+    , m_logtask_synccnt
     , m_logtask_fsynctime / 1e6);
   }
 
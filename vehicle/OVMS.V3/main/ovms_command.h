@@ -36,6 +36,7 @@
 #include <map>
 #include <set>
 #include <limits.h>
+#include <atomic>
 #include "ovms.h"
 #include "ovms_utils.h"
 #include "ovms_mutex.h"
@@ -53,6 +54,7 @@ class OvmsWriter;
 class OvmsCommand;
 class OvmsCommandMap;
 class LogBuffers;
+class OvmsSemaphore;
 typedef std::map<TaskHandle_t, LogBuffers*> PartialLogs;
 typedef bool (*InsertCallback)(OvmsWriter* writer, void* userData, char);
 
@@ -366,10 +368,17 @@ class OvmsCommandApp : public OvmsWriter
     size_t m_logfile_maxsize;
     TaskHandle_t m_logtask;
     OvmsMutex m_logtask_mutex;
-    QueueHandle_t m_logtask_queue;
+    OvmsSemaphore* m_logtask_exitack;         // set by StopLogTask()
+    char* m_logbuf;                           // LogTask input ring buffer, NUL terminated entries
+    uint32_t m_logbuf_size;                   // … size, power of 2
+    std::atomic<uint32_t> m_logbuf_head;      // … write position (producers)
+    std::atomic<uint32_t> m_logbuf_tail;      // … read position (LogTask)
+    OvmsMutex m_logbuf_mutex;                 // … serializes producers
     uint32_t m_logtask_dropcnt;
     uint32_t m_logfile_cyclecnt;
     uint32_t m_logtask_linecnt;
+    uint32_t m_logtask_blockcnt;
+    uint32_t m_logtask_synccnt;
     uint32_t m_logtask_fsynctime;
     time_t m_logtask_laststamp;
     struct timeval m_logtask_basetime;
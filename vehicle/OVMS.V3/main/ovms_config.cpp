@@ -36,6 +36,7 @@ static const char *TAG = "config";
 #include <sys/types.h>
 #include <string.h>
 #include <sstream>
+#include <algorithm>
 #include <dirent.h>
 #include "crypt_base64.h"
 #include "ovms_config.h"
@@ -139,8 +140,16 @@ void config_set(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, c
     return;
     }
 
-  p->SetValue(argv[1],argv[2]);
-  writer->puts("Parameter has been set.");
+  if ((argc % 2) == 0)
+    {
+    writer->puts("Error: instance/value pairs expected");
+    return;
+    }
+
+  OvmsConfigTransaction txn;
+  for (int i = 1; i < argc; i += 2)
+    p->SetValue(argv[i],argv[i+1]);
+  writer->puts((argc > 3) ? "Parameters have been set." : "Parameter has been set.");
   }
 
 void config_rm(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc, const char* const* argv)
@@ -228,6 +237,9 @@ OvmsConfig::OvmsConfig()
   ESP_LOGI(TAG, "Initialising CONFIG (1400)");
 
   m_mounted = false;
+  m_txn_depth = 0;
+  m_txn_saving = NULL;
+  m_generation = 1;
 
   OvmsCommand* cmd_store = MyCommandApp.RegisterCommand("store","STORE framework");
   cmd_store->RegisterCommand("mount","Mount STORE",store_mount);
@@ -235,7 +247,7 @@ OvmsConfig::OvmsConfig()
 
   OvmsCommand* cmd_config = MyCommandApp.RegisterCommand("config","CONFIG framework");
   cmd_config->RegisterCommand("list","Show configuration parameters/instances",config_list,"[<param>]",0,1, true, config_validate);
-  cmd_config->RegisterCommand("set","Set parameter:instance=value",config_set,"<param> <instance> <value>",3,3, true, config_validate);
+  cmd_config->RegisterCommand("set","Set parameter:instance=value",config_set,"<param> <instance> <value> [<instance> <value> …]",3,31, true, config_validate);
   cmd_config->RegisterCommand("rm","Remove parameter:instance",config_rm,"<param> {<instance> | *}",2,2, true, config_validate);
 
 #ifdef CONFIG_OVMS_SC_ZIP
@@ -298,8 +310,10 @@ esp_err_t OvmsConfig::mount()
   while ((dp = readdir(dir)) != NULL)
     {
     // Register the param in case this was not already done
-    if (CachedParam(dp->d_name) == NULL)
-      RegisterParam(dp->d_name, "", true, false);
+    // (".<param>" = temporary file of an interrupted update, see RewriteConfig())
+    const char* name = (dp->d_name[0] == '.') ? dp->d_name+1 : dp->d_name;
+    if (*name && CachedParam(name) == NULL)
+      RegisterParam(name, "", true, false);
     }
   closedir(dir);
 
@@ -310,6 +324,7 @@ esp_err_t OvmsConfig::mount()
     }
   upgrade();
 
+  m_generation.fetch_add(1);
   MyEvents.SignalEvent("config.mounted", NULL);
   return ESP_OK;
   }
@@ -323,6 +338,7 @@ esp_err_t OvmsConfig::unmount()
     {
     esp_vfs_fat_spiflash_unmount("/store", m_store_wlh);
     m_mounted = false;
+    m_generation.fetch_add(1);
     MyEvents.SignalEvent("config.unmounted", NULL);
     }
 
@@ -399,6 +415,7 @@ void OvmsConfig::RegisterParam(std::string name, std::string title, bool writabl
     {
     OvmsConfigParam* p = new OvmsConfigParam(name, title, writable, readable);
     m_map[name] = p;
+    m_generation.fetch_add(1);
     }
   else
     {
@@ -412,9 +429,22 @@ void OvmsConfig::DeregisterParam(std::string name)
   auto k = m_map.find(name);
   if (k != m_map.end())
     {
+    // drop pending transaction write, wait for a running Commit() to finish it:
+    m_txn_lock.Lock();
+    auto d = std::find(m_txn_dirty.begin(), m_txn_dirty.end(), k->second);
+    if (d != m_txn_dirty.end())
+      m_txn_dirty.erase(d);
+    while (m_txn_saving == k->second)
+      {
+      m_txn_lock.Unlock();
+      vTaskDelay(1);
+      m_txn_lock.Lock();
+      }
+    m_txn_lock.Unlock();
     k->second->DeleteParam();
     delete k->second;
     m_map.erase(k);
+    m_generation.fetch_add(1);
     }
   }
 
@@ -469,17 +499,29 @@ void OvmsConfig::DeleteInstance(std::string param, std::string instance)
     }
   }
 
-std::string OvmsConfig::GetParamValue(std::string param, std::string instance, std::string defvalue)
+std::string OvmsConfig::GetParamValue(const std::string& param, const std::string& instance, const std::string& defvalue)
+  {
+  const std::string* value = FindParamValue(param.c_str(), instance);
+  return value ? *value : defvalue;
+  }
+
+std::string OvmsConfig::GetParamValue(const char* param, const char* instance, const char* defvalue)
+  {
+  const std::string* value = FindParamValue(param, instance);
+  return value ? *value : std::string(defvalue);
+  }
+
+/**
+ * FindParamValue: get pointer to param instance value
+ *  Returns NULL if the param or instance is not defined. The pointer is valid
+ *  until the next change of the instance.
+ */
+const std::string* OvmsConfig::FindParamValue(const char* param, const std::string& instance)
   {
   OvmsConfigParam *p = CachedParam(param);
-  if (p && p->IsDefined(instance))
-    {
-    return p->GetValue(instance);
-    }
-  else
-    {
-    return defvalue;
-    }
+  if (!p)
+    return NULL;
+  return p->FindValue(instance);
   }
 
 std::string OvmsConfig::GetParamValueBinary(std::string param, std::string instance, std::string defvalue, BinaryEncoding_t encoding /*=Encoding_HEX*/)
@@ -504,38 +546,63 @@ std::string OvmsConfig::GetParamValueBinary(std::string param, std::string insta
     }
   }
 
-int OvmsConfig::GetParamValueInt(std::string param, std::string instance, int defvalue)
+int OvmsConfig::GetParamValueInt(const std::string& param, const std::string& instance, int defvalue)
   {
-  std::string value = GetParamValue(param,instance);
-  if (value.length() == 0) return defvalue;
-  return atoi(value.c_str());
+  return GetParamValueInt(param.c_str(), instance.c_str(), defvalue);
   }
 
-float OvmsConfig::GetParamValueFloat(std::string param, std::string instance, float defvalue)
+int OvmsConfig::GetParamValueInt(const char* param, const char* instance, int defvalue)
   {
-  std::string value = GetParamValue(param,instance);
-  if (value.length() == 0) return defvalue;
-  return atof(value.c_str());
+  const std::string* value = FindParamValue(param, instance);
+  if (!value || value->empty()) return defvalue;
+  return atoi(value->c_str());
   }
 
-bool OvmsConfig::GetParamValueBool(std::string param, std::string instance, bool defvalue)
+float OvmsConfig::GetParamValueFloat(const std::string& param, const std::string& instance, float defvalue)
   {
-  std::string value = GetParamValue(param,instance);
-  if (value.length() == 0) return defvalue;
-  return strtobool(value);
+  return GetParamValueFloat(param.c_str(), instance.c_str(), defvalue);
   }
 
-bool OvmsConfig::IsDefined(std::string param, std::string instance)
+float OvmsConfig::GetParamValueFloat(const char* param, const char* instance, float defvalue)
+  {
+  const std::string* value = FindParamValue(param, instance);
+  if (!value || value->empty()) return defvalue;
+  return atof(value->c_str());
+  }
+
+bool OvmsConfig::GetParamValueBool(const std::string& param, const std::string& instance, bool defvalue)
+  {
+  return GetParamValueBool(param.c_str(), instance.c_str(), defvalue);
+  }
+
+bool OvmsConfig::GetParamValueBool(const char* param, const char* instance, bool defvalue)
+  {
+  const std::string* value = FindParamValue(param, instance);
+  if (!value || value->empty()) return defvalue;
+  return strtobool(*value);
+  }
+
+bool OvmsConfig::IsDefined(const std::string& param, const std::string& instance)
+  {
+  return IsDefined(param.c_str(), instance.c_str());
+  }
+
+bool OvmsConfig::IsDefined(const char* param, const char* instance)
   {
   OvmsConfigParam *p = CachedParam(param);
   if (p == NULL) return false;
   return p->IsDefined(instance);
   }
 
-OvmsConfigParam* OvmsConfig::CachedParam(std::string param)
+OvmsConfigParam* OvmsConfig::CachedParam(const std::string& param)
+  {
+  return CachedParam(param.c_str());
+  }
+
+OvmsConfigParam* OvmsConfig::CachedParam(const char* param)
   {
   if (!m_mounted) return NULL;
-  OvmsConfigParam* const* p = m_map.FindUniquePrefix(param.c_str());
+  OvmsConfigParam* const* p = m_map.FindUniquePrefix(param);
   if (!p)
     return NULL;
   return *p;
@@ -550,6 +617,68 @@ bool OvmsConfig::ProtectedPath(std::string path)
 #endif // #ifdef CONFIG_OVMS_DEV_CONFIGVFS
   }
 
+/**
+ * BeginTransaction: start batch of config changes
+ *  Param file writes and "config.changed" events are deferred until the matching Commit(),
+ *  so every param changed is written & signaled once, regardless of the number of changes.
+ *  Values are updated in memory immediately. Transactions may be nested; changes are
+ *  flushed on the outermost Commit(). As the config store is global, changes done by
+ *  other tasks in the meantime are deferred as well. Use OvmsConfigTransaction to
+ *  bind a transaction to a scope.
+ */
+void OvmsConfig::BeginTransaction()
+  {
+  OvmsMutexLock lock(&m_txn_lock);
+  m_txn_depth++;
+  }
+
+/**
+ * Commit: end batch of config changes, write & signal changed params
+ */
+void OvmsConfig::Commit()
+  {
+  m_txn_lock.Lock();
+  if (m_txn_depth == 0 || --m_txn_depth > 0)
+    {
+    m_txn_lock.Unlock();
+    return;
+    }
+
+  // Params are taken from the dirty list one at a time, so DeregisterParam() can
+  // drop pending ones; the param being written is guarded by m_txn_saving.
+  // A new transaction begun meanwhile takes over the remaining params, as
+  // does a Commit() already writing in another task.
+  while (m_txn_depth == 0 && m_txn_saving == NULL && !m_txn_dirty.empty())
+    {
+    m_txn_saving = m_txn_dirty.front();
+    m_txn_dirty.erase(m_txn_dirty.begin());
+    m_txn_lock.Unlock();
+    m_txn_saving->Save();
+    m_txn_lock.Lock();
+    m_txn_saving = NULL;
+    }
+  m_txn_lock.Unlock();
+  }
+
+bool OvmsConfig::InTransaction()
+  {
+  return (m_txn_depth > 0);
+  }
+
+/**
+ * DeferWrite: register param change for the running transaction
+ *  Returns false if no transaction is running, i.e. the change needs to be written now.
+ */
+bool OvmsConfig::DeferWrite(OvmsConfigParam* param)
+  {
+  OvmsMutexLock lock(&m_txn_lock);
+  if (m_txn_depth == 0)
+    return false;
+  if (std::find(m_txn_dirty.begin(), m_txn_dirty.end(), param) == m_txn_dirty.end())
+    m_txn_dirty.push_back(param);
+  return true;
+  }
+
 /**
  * GetParamMap: get map (copy) of param instances
  */
@@ -821,6 +950,18 @@ void OvmsConfigParam::LoadConfig()
   path.append(m_name);
   // ESP_LOGI(TAG, "Trying %s",path.c_str());
   FILE* f = fopen(path.c_str(), "r");
+  if (!f)
+    {
+    // Complete an interrupted RewriteConfig():
+    std::string tmppath(OVMS_CONFIGPATH);
+    tmppath.append("/.");
+    tmppath.append(m_name);
+    if (rename(tmppath.c_str(), path.c_str()) == 0)
+      {
+      ESP_LOGW(TAG, "LoadConfig: recovered '%s' from interrupted update", path.c_str());
+      f = fopen(path.c_str(), "r");
+      }
+    }
   if (f)
     {
     char* buf = new char[OVMS_MAXVALSIZE];
@@ -859,6 +1000,7 @@ void OvmsConfigParam::LoadConfig()
     fclose(f);
     }
   m_loaded = true;
+  MyConfig.m_generation.fetch_add(1);
   }
 
 void OvmsConfigParam::SetValue(std::string instance, std::string value)
@@ -866,8 +1008,12 @@ void OvmsConfigParam::SetValue(std::string instance, std::string value)
   if (m_map.find(instance) == m_map.end() || m_map[instance] != value)
     {
     m_map[instance] = value;
-    RewriteConfig();
-    MyEvents.SignalEvent("config.changed", this);
+    MyConfig.m_generation.fetch_add(1);
+    if (!MyConfig.DeferWrite(this))
+      {
+      RewriteConfig();
+      MyEvents.SignalEvent("config.changed", this);
+      }
     }
   }
 
@@ -877,8 +1023,10 @@ void OvmsConfigParam::DeleteParam()
 
   std::string path(OVMS_CONFIGPATH);
   path.append("/");
+  std::string tmppath = path + "." + m_name;
   path.append(m_name);
   unlink(path.c_str());
+  unlink(tmppath.c_str());
   MyEvents.SignalEvent("config.changed", this);
   }
 
@@ -889,14 +1037,21 @@ bool OvmsConfigParam::DeleteInstance(std::string instance)
   if (k != m_map.end())
     {
     m_map.erase(k);
-    RewriteConfig();
+    MyConfig.m_generation.fetch_add(1);
     ret = true;
+    if (MyConfig.DeferWrite(this))
+      return ret;
+    RewriteConfig();
+    }
+  else if (MyConfig.InTransaction())
+    {
+    return ret;
     }
   MyEvents.SignalEvent("config.changed", this);
   return ret;
   }
 
-std::string OvmsConfigParam::GetValue(std::string instance)
+std::string OvmsConfigParam::GetValue(const std::string& instance)
   {
   auto k = m_map.find(instance);
   if (k == m_map.end())
@@ -905,7 +1060,16 @@ std::string OvmsConfigParam::GetValue(std::string instance)
     return k->second;
   }
 
-bool OvmsConfigParam::IsDefined(std::string instance)
+const std::string* OvmsConfigParam::FindValue(const std::string& instance)
+  {
+  auto k = m_map.find(instance);
+  if (k == m_map.end())
+    return NULL;
+  else
+    return &k->second;
+  }
+
+bool OvmsConfigParam::IsDefined(const std::string& instance)
   {
   if (instance.empty())
     return !m_map.empty();
@@ -937,16 +1101,22 @@ std::string OvmsConfigParam::GetName()
   return m_name;
   }
 
+/**
+ * RewriteConfig: write param file
+ *  The file is written to ".<param>" first and then renamed, so an interruption
+ *  cannot leave a truncated param file. See LoadConfig() for the recovery.
+ */
 void OvmsConfigParam::RewriteConfig()
   {
   OvmsMutexLock store_lock(&MyConfig.m_store_lock);
 
   std::string path(OVMS_CONFIGPATH);
   path.append("/");
+  std::string tmppath = path + "." + m_name;
   path.append(m_name);
-  FILE* f = fopen(path.c_str(), "w");
+  FILE* f = fopen(tmppath.c_str(), "w");
   if (!f)
-    ESP_LOGE(TAG, "RewriteConfig: can't open '%s': %s", path.c_str(), strerror(errno));
+    ESP_LOGE(TAG, "RewriteConfig: can't open '%s': %s", tmppath.c_str(), strerror(errno));
   else
     {
 #ifdef OVMS_PERSIST_METADATA
@@ -959,8 +1129,19 @@ void OvmsConfigParam::RewriteConfig()
       {
       fprintf(f,"%s\t%s\n",it->first.c_str(),it->second.c_str());
       }
-    if (fclose(f))
-      ESP_LOGE(TAG, "RewriteConfig: error writing '%s': %s", path.c_str(), strerror(errno));
+    bool failed = ferror(f);
+    if (fclose(f) || failed)
+      {
+      ESP_LOGE(TAG, "RewriteConfig: error writing '%s': %s", tmppath.c_str(), strerror(errno));
+      unlink(tmppath.c_str());
+      }
+    else
+      {
+      // FAT cannot rename onto an existing file:
+      unlink(path.c_str());
+      if (rename(tmppath.c_str(), path.c_str()) != 0)
+        ESP_LOGE(TAG, "RewriteConfig: can't rename '%s': %s", tmppath.c_str(), strerror(errno));
+      }
     }
   }
 
@@ -971,7 +1152,8 @@ void OvmsConfigParam::Load()
 
 void OvmsConfigParam::Save()
   {
-  if (m_name != "")
+  MyConfig.m_generation.fetch_add(1);
+  if (m_name != "" && !MyConfig.DeferWrite(this))
     {
     RewriteConfig();
     MyEvents.SignalEvent("config.changed", this);
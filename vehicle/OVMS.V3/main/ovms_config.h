@@ -33,6 +33,8 @@
 
 #include "string"
 #include "map"
+#include "vector"
+#include <atomic>
 #include "esp_err.h"
 #include "esp_vfs_fat.h"
 #include "wear_levelling.h"
@@ -51,8 +53,9 @@ class OvmsConfigParam
     void SetValue(std::string instance, std::string value);
     void DeleteParam();
     bool DeleteInstance(std::string instance);
-    std::string GetValue(std::string instance);
-    bool IsDefined(std::string instance);
+    std::string GetValue(const std::string& instance);
+    const std::string* FindValue(const std::string& instance);
+    bool IsDefined(const std::string& instance);
     bool Writable();
     bool Readable();
     void SetAccess(bool writable, bool readable);
@@ -104,17 +107,33 @@ class OvmsConfig
     void SetParamValueFloat(std::string param, std::string instance, float value);
     void SetParamValueBool(std::string param, std::string instance, bool value);
     void DeleteInstance(std::string param, std::string instance);
-    std::string GetParamValue(std::string param, std::string instance, std::string defvalue = "");
+    std::string GetParamValue(const std::string& param, const std::string& instance, const std::string& defvalue = "");
     std::string GetParamValueBinary(std::string param, std::string instance, std::string defvalue = "", BinaryEncoding_t encoding=Encoding_HEX);
-    int GetParamValueInt(std::string param, std::string instance, int defvalue = 0);
-    float GetParamValueFloat(std::string param, std::string instance, float defvalue = 0);
-    bool GetParamValueBool(std::string param, std::string instance, bool defvalue = false);
-    bool IsDefined(std::string param, std::string instance);
+    int GetParamValueInt(const std::string& param, const std::string& instance, int defvalue = 0);
+    float GetParamValueFloat(const std::string& param, const std::string& instance, float defvalue = 0);
+    bool GetParamValueBool(const std::string& param, const std::string& instance, bool defvalue = false);
+    bool IsDefined(const std::string& param, const std::string& instance);
     bool ProtectedPath(std::string path);
-    OvmsConfigParam* CachedParam(std::string param);
+    OvmsConfigParam* CachedParam(const std::string& param);
+
+  public:
+    // Overloads for C string arguments, avoiding temporary std::string copies:
+    std::string GetParamValue(const char* param, const char* instance, const char* defvalue = "");
+    int GetParamValueInt(const char* param, const char* instance, int defvalue = 0);
+    float GetParamValueFloat(const char* param, const char* instance, float defvalue = 0);
+    bool GetParamValueBool(const char* param, const char* instance, bool defvalue = false);
+    bool IsDefined(const char* param, const char* instance);
+    OvmsConfigParam* CachedParam(const char* param);
+    const std::string* FindParamValue(const char* param, const std::string& instance);
     ConfigParamMap GetParamMap(std::string param);
     void SetParamMap(std::string param, ConfigParamMap& map);
 
+  public:
+    void BeginTransaction();
+    void Commit();
+    bool InTransaction();
+    bool DeferWrite(OvmsConfigParam* param);
+
 #ifdef CONFIG_OVMS_SC_ZIP
   public:
     bool Backup(std::string path, std::string password, OvmsWriter* writer=NULL, int verbosity=1024);
@@ -137,11 +156,85 @@ class OvmsConfig
     esp_vfs_fat_mount_config_t m_store_fat;
     wl_handle_t m_store_wlh;
 
+  protected:
+    OvmsMutex m_txn_lock;
+    int m_txn_depth;                              // BeginTransaction() nesting level
+    std::vector<OvmsConfigParam*> m_txn_dirty;    // params changed during the transaction
+    OvmsConfigParam* m_txn_saving;                // param currently written by Commit()
+
   public:
     ConfigMap m_map;
     OvmsMutex m_store_lock;
+    std::atomic<uint32_t> m_generation;           // incremented on every config change (see ConfigRef)
   };
 
 extern OvmsConfig MyConfig;
 
+/**
+ * OvmsConfigTransaction: scoped config transaction
+ *  Defers config file writes & "config.changed" events until the object goes out of scope.
+ */
+class OvmsConfigTransaction
+  {
+  public:
+    OvmsConfigTransaction() { MyConfig.BeginTransaction(); }
+    ~OvmsConfigTransaction() { MyConfig.Commit(); }
+  };
+
+/**
+ * ConfigRef: typed config value handle
+ *  Caches the parsed value until the next config change, so reading it costs
+ *  a counter check and a pointer dereference. Use this for config values read
+ *  frequently, e.g. in tickers or per CAN frame:
+ *  
+ *    ConfigRef<int> m_cfg_maxspeed { "xyz", "maxspeed", 130 };
+ *    …
+ *    if (speed > m_cfg_maxspeed) …
+ *  
+ *  Supported types: int, float, bool, std::string.
+ *  Note: not synchronized, the value may be reloaded on any read. Share instances
+ *  between tasks only for scalar types.
+ */
+inline void ConfigRefLoad(int& value, const char* param, const char* instance, const int& defvalue)
+  { value = MyConfig.GetParamValueInt(param, instance, defvalue); }
+inline void ConfigRefLoad(float& value, const char* param, const char* instance, const float& defvalue)
+  { value = MyConfig.GetParamValueFloat(param, instance, defvalue); }
+inline void ConfigRefLoad(bool& value, const char* param, const char* instance, const bool& defvalue)
+  { value = MyConfig.GetParamValueBool(param, instance, defvalue); }
+inline void ConfigRefLoad(std::string& value, const char* param, const char* instance, const std::string& defvalue)
+  {
+  const std::string* v = MyConfig.FindParamValue(param, instance);
+  value = v ? *v : defvalue;
+  }
+
+template <typename T> class ConfigRef
+  {
+  public:
+    ConfigRef(const char* param, const char* instance, const T& defvalue = T())
+      : m_param(param), m_instance(instance), m_defvalue(defvalue), m_value(defvalue), m_generation(0)
+      {
+      }
+
+  public:
+    const T& Get()
+      {
+      uint32_t generation = MyConfig.m_generation.load(std::memory_order_acquire);
+      if (m_generation != generation)
+        {
+        ConfigRefLoad(m_value, m_param, m_instance, m_defvalue);
+        m_generation = generation;
+        }
+      return m_value;
+      }
+    operator const T&() { return Get(); }
+    const T& operator*() { return Get(); }
+
+  protected:
+    const char* m_param;                          // Note: must be static (string literal)
+    const char* m_instance;                       // Note: must be static (string literal)
+    T m_defvalue;
+    T m_value;
+    uint32_t m_generation;
+  };
+
 #endif //#ifndef __CONFIG_H__
@@ -101,7 +101,7 @@ void event_status(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc,
   if (cbe != NULL)
     {
     writer->printf("Currently dispatching:\n");
-    writer->printf("  Event: %s\n",MyEvents.m_current_event.c_str());
+    writer->printf("  Event: %s\n",MyEvents.m_current_event);
     writer->printf("  To:    %s\n",cbe->m_caller.c_str());
     writer->printf("  For:   %u second(s)\n",monotonictime-MyEvents.m_current_started);
     }
@@ -169,6 +169,12 @@ OvmsEvents::OvmsEvents()
   ESP_LOGI(TAG, "Initialising EVENTS (1200)");
 
   m_current_callback = NULL;
+  m_current_event = NULL;
+  m_current_started = 0;
+
+  // Init dispatch table, id 0 = EVENT_ID_NONE:
+  m_table.push_back(NULL);
+  m_wildcard = FindEntry("*", true);
 
 #ifdef CONFIG_OVMS_DEV_DEBUGEVENTS
   m_trace = true;
@@ -211,10 +217,8 @@ void OvmsEvents::EventTask()
         case EVENT_none:
           break;
         case EVENT_signal:
-          m_current_event = msg.body.signal.event;
           HandleQueueSignalEvent(&msg);
           esp_task_wdt_reset(); // Reset WATCHDOG timer for this task
-          m_current_event.clear();
           break;
         default:
           break;
@@ -239,78 +243,126 @@ void OvmsEvents::EventTask()
 
 void OvmsEvents::HandleQueueSignalEvent(event_queue_t* msg)
   {
+  m_current_event = msg->body.signal.event;
+
   // Log everything but the ticker & clock signals
-  if (!startsWith(m_current_event, "ticker.") && !startsWith(m_current_event, "clock."))
+  if (strncmp(m_current_event, "ticker.", 7) != 0 && strncmp(m_current_event, "clock.", 6) != 0)
     {
     if (m_trace)
-      ESP_LOGI(TAG, "Signal(%s)",m_current_event.c_str());
+      ESP_LOGI(TAG, "Signal(%s)",m_current_event);
     else
-      ESP_LOGD(TAG, "Signal(%s)",m_current_event.c_str());
+      ESP_LOGD(TAG, "Signal(%s)",m_current_event);
     }
 
-  auto k = m_map.find(m_current_event);
-  if (k != m_map.end())
-    {
-    EventCallbackList* el = k->second;
-    if (el)
-      {
-      for (EventCallbackList::iterator itc=el->begin(); itc!=el->end(); ++itc)
-        {
-        m_current_started = monotonictime;
-        m_current_callback = *itc;
-        m_current_callback->m_callback(m_current_event, msg->body.signal.data);
-        m_current_callback = NULL;
-        }
-      }
-    }
+  // Listeners may have registered after the event has been signalled:
+  EventEntry* entry = msg->body.signal.entry;
+  if (!entry)
+    entry = FindEntry(m_current_event);
 
-  k = m_map.find("*");
-  if (k != m_map.end())
-    {
-    EventCallbackList* el = k->second;
-    if (el)
-      {
-      for (EventCallbackList::iterator itc=el->begin(); itc!=el->end(); ++itc)
-        {
-        m_current_started = monotonictime;
-        m_current_callback = *itc;
-        m_current_callback->m_callback(m_current_event, msg->body.signal.data);
-        m_current_callback = NULL;
-        }
-      }
-    }
+  // std::string copy of the event name for legacy callbacks, created on demand:
+  std::string eventstr;
+
+  event_id_t id = entry ? entry->id : EVENT_ID_NONE;
+  if (entry && entry->callbacks)
+    DispatchEvent(entry->callbacks, id, m_current_event, eventstr, msg->body.signal.data);
+  if (m_wildcard->callbacks)
+    DispatchEvent(m_wildcard->callbacks, id, m_current_event, eventstr, msg->body.signal.data);
 
   m_current_started = monotonictime;
   MyScripts.EventScript(m_current_event, msg->body.signal.data);
 
+  m_current_event = NULL;
   FreeQueueSignalEvent(msg);
   }
 
+void OvmsEvents::DispatchEvent(EventCallbackList* el, event_id_t id, const char* event, std::string& eventstr, void* data)
+  {
+  for (EventCallbackList::iterator itc=el->begin(); itc!=el->end(); ++itc)
+    {
+    m_current_started = monotonictime;
+    m_current_callback = *itc;
+    if (m_current_callback->m_idcallback)
+      {
+      m_current_callback->m_idcallback(id, event, data);
+      }
+    else
+      {
+      if (eventstr.empty())
+        eventstr = event;
+      m_current_callback->m_callback(eventstr, data);
+      }
+    m_current_callback = NULL;
+    }
+  }
+
 void OvmsEvents::FreeQueueSignalEvent(event_queue_t* msg)
   {
   if (msg->body.signal.donefn != NULL)
     {
     msg->body.signal.donefn(msg->body.signal.event, msg->body.signal.data);
     }
-  free(msg->body.signal.event);
+  if (!msg->body.signal.entry)
+    free((void*)msg->body.signal.event);
   }
 
-void OvmsEvents::RegisterEvent(std::string caller, std::string event, EventCallback callback)
+/**
+ * FindEntry: look up (and optionally intern) an event name
+ */
+EventEntry* OvmsEvents::FindEntry(const char* event, bool create /*=false*/)
   {
-  auto k = m_map.find(event);
-  if (k == m_map.end())
-    {
-    m_map[event] = new EventCallbackList();
-    k = m_map.find(event);
-    }
-  if (k == m_map.end())
+  OvmsMutexLock lock(&m_ids_mutex);
+  auto k = m_ids.find(event);
+  if (k != m_ids.end())
+    return k->second;
+  if (!create)
+    return NULL;
+
+  EventEntry* entry = new EventEntry;
+  entry->id = m_table.size();
+  entry->name = strdup(event);
+  entry->callbacks = NULL;
+  m_ids[entry->name] = entry;
+  m_table.push_back(entry);
+  return entry;
+  }
+
+event_id_t OvmsEvents::GetEventId(const char* event)
+  {
+  EventEntry* entry = FindEntry(event);
+  return entry ? entry->id : EVENT_ID_NONE;
+  }
+
+const char* OvmsEvents::GetEventName(event_id_t id)
+  {
+  OvmsMutexLock lock(&m_ids_mutex);
+  if (id == EVENT_ID_NONE || id >= m_table.size())
+    return NULL;
+  return m_table[id]->name;
+  }
+
+void OvmsEvents::RegisterEntry(std::string event, EventCallbackEntry* ec)
+  {
+  EventEntry* entry = FindEntry(event.c_str(), true);
+  if (!entry->callbacks)
     {
-    ESP_LOGE(TAG, "Problem registering event %s for caller %s",event.c_str(),caller.c_str());
-    return;
+    entry->callbacks = new EventCallbackList();
+    m_map[event] = entry->callbacks;
     }
+  entry->callbacks->push_back(ec);
+  }
+
+void OvmsEvents::RegisterEvent(std::string caller, std::string event, EventCallback callback)
+  {
+  RegisterEntry(event, new EventCallbackEntry(caller,callback));
+  }
 
-  EventCallbackList *el = k->second;
-  el->push_back(new EventCallbackEntry(caller,callback));
+/**
+ * RegisterEventId: register a listener that receives the event id & interned
+ *  name instead of a std::string copy (no allocation per event)
+ */
+void OvmsEvents::RegisterEventId(std::string caller, std::string event, EventIdCallback callback)
+  {
+  RegisterEntry(event, new EventCallbackEntry(caller,callback));
   }
 
 void OvmsEvents::DeregisterEvent(std::string caller)
@@ -335,6 +387,9 @@ void OvmsEvents::DeregisterEvent(std::string caller)
       }
     if (el->empty())
       {
+      EventEntry* entry = FindEntry(itm->first.c_str());
+      if (entry)
+        entry->callbacks = NULL;
       itm = m_map.erase(itm);
       delete el;
       }
@@ -345,14 +400,14 @@ void OvmsEvents::DeregisterEvent(std::string caller)
     }
   }
 
-static void CheckQueueOverflow(const char* from, char* event)
+static void CheckQueueOverflow(const char* from, const char* event)
   {
   EventCallbackEntry* cbe = MyEvents.m_current_callback;
   if (cbe != NULL)
     {
     ESP_LOGE(TAG, "%s: queue overflow (running %s->%s for %u sec), event '%s' dropped",
       from,
-      MyEvents.m_current_event.c_str(),
+      MyEvents.m_current_event ? MyEvents.m_current_event : "-",
       cbe->m_caller.c_str(),
       monotonictime-MyEvents.m_current_started,
       event);
@@ -433,15 +488,18 @@ bool OvmsEvents::ScheduleEvent(event_queue_t* msg, uint32_t delay_ms)
   return true;
   }
 
-void OvmsEvents::SignalEvent(std::string event, void* data, event_signal_done_fn callback /*=NULL*/,
+void OvmsEvents::SignalEvent(const char* event, void* data, event_signal_done_fn callback /*=NULL*/,
                              uint32_t delay_ms /*=0*/)
   {
   event_queue_t msg;
   memset(&msg, 0, sizeof(msg));
 
   msg.type = EVENT_signal;
-  msg.body.signal.event = (char*)ExternalRamMalloc(event.size()+1);
-  strcpy(msg.body.signal.event, event.c_str());
+  msg.body.signal.entry = FindEntry(event);
+  if (msg.body.signal.entry)
+    msg.body.signal.event = msg.body.signal.entry->name;
+  else
+    msg.body.signal.event = ExternalRamAllocated::strdup(event);
   msg.body.signal.data = data;
   msg.body.signal.donefn = callback;
 
@@ -463,15 +521,18 @@ void OvmsEvents::SignalEvent(std::string event, void* data, event_signal_done_fn
     }
   }
 
-void OvmsEvents::SignalEvent(std::string event, void* data, size_t length,
+void OvmsEvents::SignalEvent(const char* event, void* data, size_t length,
                              uint32_t delay_ms /*=0*/)
   {
   event_queue_t msg;
   memset(&msg, 0, sizeof(msg));
 
   msg.type = EVENT_signal;
-  msg.body.signal.event = (char*)ExternalRamMalloc(event.size()+1);
-  strcpy(msg.body.signal.event, event.c_str());
+  msg.body.signal.entry = FindEntry(event);
+  if (msg.body.signal.entry)
+    msg.body.signal.event = msg.body.signal.entry->name;
+  else
+    msg.body.signal.event = ExternalRamAllocated::strdup(event);
   if (data != NULL)
     {
     msg.body.signal.data = ExternalRamMalloc(length);
@@ -601,6 +662,12 @@ EventCallbackEntry::EventCallbackEntry(std::string caller, EventCallback callbac
   m_callback = callback;
   }
 
+EventCallbackEntry::EventCallbackEntry(std::string caller, EventIdCallback callback)
+  {
+  m_caller = caller;
+  m_idcallback = callback;
+  }
+
 EventCallbackEntry::~EventCallbackEntry()
   {
   }
@@ -35,6 +35,7 @@
 #include <functional>
 #include <map>
 #include <list>
+#include <vector>
 #include <esp_event.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -42,22 +43,44 @@
 #include "freertos/timers.h"
 #include "ovms_command.h"
 #include "ovms_mutex.h"
+#include "ovms_utils.h"
+
+typedef uint16_t event_id_t;
+#define EVENT_ID_NONE 0
 
 typedef std::function<void(std::string,void*)> EventCallback;
+typedef std::function<void(event_id_t,const char*,void*)> EventIdCallback;
 
 class EventCallbackEntry
   {
   public:
     EventCallbackEntry(std::string caller, EventCallback callback);
+    EventCallbackEntry(std::string caller, EventIdCallback callback);
     virtual ~EventCallbackEntry();
 
   public:
     std::string m_caller;
     EventCallback m_callback;
+    EventIdCallback m_idcallback;
   };
 
 typedef std::list<EventCallbackEntry*> EventCallbackList;
 
+/**
+ * EventEntry: interned event name & dispatch table entry
+ *  Event names get interned when the first listener registers for them.
+ *  Entries are never freed, so the name pointer can be held indefinitely.
+ */
+struct EventEntry
+  {
+  event_id_t id;
+  const char* name;
+  EventCallbackList* callbacks;
+  };
+
+typedef std::map<const char*, EventEntry*, CmpStrOp> EventIdMap;
+typedef std::vector<EventEntry*> EventTable;
+
 class EventMap : public  std::map<std::string, EventCallbackList*>
   {
   public:
@@ -80,7 +103,8 @@ typedef struct
     {
     struct
       {
-      char* event;
+      const char* event;          // interned name if entry is set, else allocated
+      EventEntry* entry;
       void* data;
       event_signal_done_fn donefn;
       } signal;
@@ -98,9 +122,18 @@ class OvmsEvents
 
   public:
     void RegisterEvent(std::string caller, std::string event, EventCallback callback);
+    void RegisterEventId(std::string caller, std::string event, EventIdCallback callback);
     void DeregisterEvent(std::string caller);
-    void SignalEvent(std::string event, void* data, event_signal_done_fn callback = NULL, uint32_t delay_ms = 0);
-    void SignalEvent(std::string event, void* data, size_t length, uint32_t delay_ms = 0);
+    void SignalEvent(const char* event, void* data, event_signal_done_fn callback = NULL, uint32_t delay_ms = 0);
+    void SignalEvent(const char* event, void* data, size_t length, uint32_t delay_ms = 0);
+    void SignalEvent(const std::string& event, void* data, event_signal_done_fn callback = NULL, uint32_t delay_ms = 0)
+      { SignalEvent(event.c_str(), data, callback, delay_ms); }
+    void SignalEvent(const std::string& event, void* data, size_t length, uint32_t delay_ms = 0)
+      { SignalEvent(event.c_str(), data, length, delay_ms); }
+
+  public:
+    event_id_t GetEventId(const char* event);
+    const char* GetEventName(event_id_t id);
 
   public:
     void EventTask();
@@ -112,9 +145,16 @@ class OvmsEvents
 
   protected:
     bool ScheduleEvent(event_queue_t* msg, uint32_t delay_ms);
+    EventEntry* FindEntry(const char* event, bool create=false);
+    void RegisterEntry(std::string event, EventCallbackEntry* entry);
+    void DispatchEvent(EventCallbackList* el, event_id_t id, const char* event, std::string& eventstr, void* data);
 
   protected:
     EventMap m_map;
+    EventIdMap m_ids;
+    EventTable m_table;
+    OvmsMutex m_ids_mutex;
+    EventEntry* m_wildcard;
     TimerList m_timers;
     OvmsMutex m_timers_mutex;
 
@@ -125,7 +165,7 @@ class OvmsEvents
 
   public:
     EventCallbackEntry* m_current_callback;
-    std::string m_current_event;
+    const char* m_current_event;
     uint32_t m_current_started;
   };
 
@@ -139,9 +139,10 @@ Housekeeping::Housekeeping()
   #undef bind  // Kludgy, but works
   using std::placeholders::_1;
   using std::placeholders::_2;
+  using std::placeholders::_3;
   MyEvents.RegisterEvent(TAG,"housekeeping.init", std::bind(&Housekeeping::Init, this, _1, _2));
-  MyEvents.RegisterEvent(TAG,"ticker.10", std::bind(&Housekeeping::Metrics, this, _1, _2));
-  MyEvents.RegisterEvent(TAG,"ticker.300", std::bind(&Housekeeping::TimeLogger, this, _1, _2));
+  MyEvents.RegisterEventId(TAG,"ticker.10", std::bind(&Housekeeping::Metrics, this, _1, _2, _3));
+  MyEvents.RegisterEventId(TAG,"ticker.300", std::bind(&Housekeeping::TimeLogger, this, _1, _2, _3));
 
   // Fire off the event that causes us to be called back in Events tasks context
   MyEvents.SignalEvent("housekeeping.init", NULL);
@@ -237,10 +238,10 @@ void Housekeeping::Init(std::string event, void* data)
 
   MyEvents.SignalEvent("system.start",NULL);
 
-  Metrics(event,data); // Causes the metrics to be produced
+  Metrics(EVENT_ID_NONE, event.c_str(), data); // Causes the metrics to be produced
   }
 
-void Housekeeping::Metrics(std::string event, void* data)
+void Housekeeping::Metrics(event_id_t id, const char* event, void* data)
   {
   OvmsMetricInt* m2 = StandardMetrics.ms_m_tasks;
   if (m2 == NULL)
@@ -270,7 +271,7 @@ void Housekeeping::Metrics(std::string event, void* data)
     }
   }
 
-void Housekeeping::TimeLogger(std::string event, void* data)
+void Housekeeping::TimeLogger(event_id_t id, const char* event, void* data)
   {
   time_t rawtime;
   time ( &rawtime );
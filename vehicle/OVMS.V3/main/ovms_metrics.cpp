@@ -321,12 +321,153 @@ static duk_ret_t DukOvmsMetricFloat(duk_context *ctx)
     return 0;
   }
 
+/**
+ * Metric handles: Javascript objects bound to a metric instance
+ *  The handle keeps the metric pointer in a hidden buffer property, so accessing
+ *  the value doesn't need a name lookup. The pointer is looked up again by name
+ *  after metric removals (see OvmsMetrics::m_generation).
+ */
+typedef struct
+  {
+  OvmsMetric* metric;
+  uint32_t generation;
+  } duk_metric_handle_t;
+
+static OvmsMetric* DukOvmsMetricResolveHandle(duk_context *ctx, duk_idx_t obj_idx)
+  {
+  obj_idx = duk_normalize_index(ctx, obj_idx);
+  duk_get_prop_literal(ctx, obj_idx, "\xff" "handle");
+  duk_metric_handle_t* h = (duk_metric_handle_t*) duk_get_buffer_data(ctx, -1, NULL);
+  duk_pop(ctx);
+  if (!h)
+    return NULL;
+  uint32_t generation = MyMetrics.m_generation;
+  if (h->generation != generation)
+    {
+    duk_get_prop_string(ctx, obj_idx, "name");
+    h->metric = MyMetrics.Find(duk_to_string(ctx, -1));
+    h->generation = generation;
+    duk_pop(ctx);
+    }
+  return h->metric;
+  }
+
+static OvmsMetric* DukOvmsMetricHandleThis(duk_context *ctx)
+  {
+  duk_push_this(ctx);
+  OvmsMetric *m = DukOvmsMetricResolveHandle(ctx, -1);
+  duk_pop(ctx);
+  return m;
+  }
+
+static duk_ret_t DukOvmsMetricHandleValue(duk_context *ctx)
+  {
+  OvmsMetric *m = DukOvmsMetricHandleThis(ctx);
+  if (!m) return 0;
+  DukContext dc(ctx);
+  if (duk_opt_boolean(ctx, 0, true))
+    m->DukPush(dc);
+  else
+    dc.Push(m->AsString());
+  return 1;
+  }
+
+static duk_ret_t DukOvmsMetricHandleFloat(duk_context *ctx)
+  {
+  OvmsMetric *m = DukOvmsMetricHandleThis(ctx);
+  if (!m) return 0;
+  duk_push_number(ctx, float2double(m->AsFloat()));
+  return 1;
+  }
+
+static duk_ret_t DukOvmsMetricHandleJSON(duk_context *ctx)
+  {
+  OvmsMetric *m = DukOvmsMetricHandleThis(ctx);
+  if (!m) return 0;
+  duk_push_string(ctx, m->AsJSON().c_str());
+  return 1;
+  }
+
+static duk_ret_t DukOvmsMetricHandleIsDefined(duk_context *ctx)
+  {
+  OvmsMetric *m = DukOvmsMetricHandleThis(ctx);
+  duk_push_boolean(ctx, m && m->IsDefined());
+  return 1;
+  }
+
+static duk_ret_t DukOvmsMetricHandleIsStale(duk_context *ctx)
+  {
+  OvmsMetric *m = DukOvmsMetricHandleThis(ctx);
+  duk_push_boolean(ctx, m && m->IsStale());
+  return 1;
+  }
+
+static duk_ret_t DukOvmsMetricHandleAge(duk_context *ctx)
+  {
+  OvmsMetric *m = DukOvmsMetricHandleThis(ctx);
+  if (!m) return 0;
+  duk_push_uint(ctx, m->Age());
+  return 1;
+  }
+
+static const duk_function_list_entry DukOvmsMetricHandleMethods[] =
+  {
+  { "Value", DukOvmsMetricHandleValue, 1 },
+  { "AsFloat", DukOvmsMetricHandleFloat, 0 },
+  { "AsJSON", DukOvmsMetricHandleJSON, 0 },
+  { "IsDefined", DukOvmsMetricHandleIsDefined, 0 },
+  { "IsStale", DukOvmsMetricHandleIsStale, 0 },
+  { "Age", DukOvmsMetricHandleAge, 0 },
+  { NULL, NULL, 0 }
+  };
+
+static duk_ret_t DukOvmsMetricHandle(duk_context *ctx)
+  {
+  uint32_t generation = MyMetrics.m_generation;
+  OvmsMetric *m = MyMetrics.Find(duk_to_string(ctx, 0));
+  if (!m)
+    return 0;
+
+  duk_push_object(ctx);
+
+  // Set prototype, shared by all handles:
+  duk_push_global_stash(ctx);
+  if (!duk_get_prop_string(ctx, -1, "\xff" "MetricHandle"))
+    {
+    duk_pop(ctx);
+    duk_push_object(ctx);
+    duk_put_function_list(ctx, -1, DukOvmsMetricHandleMethods);
+    duk_dup_top(ctx);
+    duk_put_prop_string(ctx, -3, "\xff" "MetricHandle");
+    }
+  duk_set_prototype(ctx, -3);
+  duk_pop(ctx);
+
+  duk_push_string(ctx, m->m_name);
+  duk_put_prop_string(ctx, -2, "name");
+  duk_metric_handle_t* h = (duk_metric_handle_t*) duk_push_fixed_buffer(ctx, sizeof(duk_metric_handle_t));
+  h->metric = m;
+  h->generation = generation;
+  duk_put_prop_string(ctx, -2, "\xff" "handle");
+  return 1;
+  }
+
 static duk_ret_t DukOvmsMetricGetValues(duk_context *ctx)
   {
   OvmsMetric *m;
   DukContext dc(ctx);
   bool decode = duk_opt_boolean(ctx, 1, true);
-  duk_idx_t obj_idx = dc.PushObject();
+  duk_idx_t obj_idx;
+  if (duk_is_object(ctx, 2))
+    {
+    // fill the object passed:
+    duk_dup(ctx, 2);
+    obj_idx = duk_get_top_index(ctx);
+    }
+  else
+    {
+    obj_idx = dc.PushObject();
+    }
 
   // helper: set object property from metric
   auto set_metric = [&dc, obj_idx, decode](OvmsMetric *m)
@@ -340,10 +481,13 @@ static duk_ret_t DukOvmsMetricGetValues(duk_context *ctx)
 
   if (duk_is_array(ctx, 0))
     {
-    // get metric names from array:
+    // get metric names or handles from array:
     for (int i=0; duk_get_prop_index(ctx, 0, i); i++)
       {
-      m = MyMetrics.Find(duk_to_string(ctx, -1));
+      if (duk_is_object(ctx, -1))
+        m = DukOvmsMetricResolveHandle(ctx, -1);
+      else
+        m = MyMetrics.Find(duk_to_string(ctx, -1));
       if (m) set_metric(m);
       duk_pop(ctx);
       }
@@ -394,7 +538,18 @@ OvmsMetrics::OvmsMetrics()
 
   m_nextmodifier = 1;
   m_first = NULL;
+  m_generation = 0;
   m_trace = false;
+  memset(m_hashtable, 0, sizeof(m_hashtable));
+
+  // Init change journal, mark all entries as not yet written:
+  m_journal_head = 0;
+  m_journal = new metric_journal_entry_t[METRICS_JOURNAL_SIZE];
+  for (uint32_t i = 0; i < METRICS_JOURNAL_SIZE; i++)
+    {
+    m_journal[i].seq = i - METRICS_JOURNAL_SIZE;
+    m_journal[i].metric = NULL;
+    }
 
   // Register our commands
   OvmsCommand* cmd_metric = MyCommandApp.RegisterCommand("metrics","METRICS framework");
@@ -408,10 +563,11 @@ OvmsMetrics::OvmsMetrics()
 #ifdef CONFIG_OVMS_SC_JAVASCRIPT_DUKTAPE
   ESP_LOGI(TAG, "Expanding DUKTAPE javascript engine");
   DuktapeObjectRegistration* dto = new DuktapeObjectRegistration("OvmsMetrics");
-  dto->RegisterDuktapeFunction(DukOvmsMetricValue, 1, "Value");
+  dto->RegisterDuktapeFunction(DukOvmsMetricValue, 2, "Value");
   dto->RegisterDuktapeFunction(DukOvmsMetricJSON, 1, "AsJSON");
   dto->RegisterDuktapeFunction(DukOvmsMetricFloat, 1, "AsFloat");
-  dto->RegisterDuktapeFunction(DukOvmsMetricGetValues, 2, "GetValues");
+  dto->RegisterDuktapeFunction(DukOvmsMetricGetValues, 3, "GetValues");
+  dto->RegisterDuktapeFunction(DukOvmsMetricHandle, 1, "Handle");
   MyScripts.RegisterDuktapeObject(dto);
 #endif //#ifdef CONFIG_OVMS_SC_JAVASCRIPT_DUKTAPE
 
@@ -439,8 +595,29 @@ OvmsMetrics::~OvmsMetrics()
     }
   }
 
+/**
+ * HashName: FNV-1a hash of a metric name, used for the name index
+ */
+uint32_t OvmsMetrics::HashName(const char* metric)
+  {
+  uint32_t hash = 2166136261u;
+  for (const unsigned char* p = (const unsigned char*)metric; *p; p++)
+    {
+    hash ^= *p;
+    hash *= 16777619u;
+    }
+  return hash;
+  }
+
 void OvmsMetrics::RegisterMetric(OvmsMetric* metric)
   {
+  // Add to the name index. The chain link is set up before the metric
+  // gets published in the bucket, so concurrent Find() calls stay safe.
+  metric->m_namehash = HashName(metric->m_name);
+  OvmsMetric** bucket = &m_hashtable[metric->m_namehash & (METRICS_HASH_BUCKETS-1)];
+  metric->m_hashnext = *bucket;
+  *bucket = metric;
+
   // Quick simple check for if we are the first metric.
   if (m_first == NULL)
     {
@@ -475,6 +652,20 @@ void OvmsMetrics::RegisterMetric(OvmsMetric* metric)
 
 void OvmsMetrics::DeregisterMetric(OvmsMetric* metric)
   {
+  JournalRemove(metric);
+  m_generation++;
+
+  // Remove from the name index:
+  OvmsMetric** bucket = &m_hashtable[metric->m_namehash & (METRICS_HASH_BUCKETS-1)];
+  for (OvmsMetric** mp = bucket; *mp != NULL; mp = &(*mp)->m_hashnext)
+    {
+    if (*mp == metric)
+      {
+      *mp = metric->m_hashnext;
+      break;
+      }
+    }
+
   if (m_first == metric)
     {
     m_first = metric->m_next;
@@ -531,9 +722,10 @@ bool OvmsMetrics::SetFloat(const char* metric, float value)
 
 OvmsMetric* OvmsMetrics::Find(const char* metric)
   {
-  for (OvmsMetric* m=m_first; m != NULL; m=m->m_next)
+  uint32_t hash = HashName(metric);
+  for (OvmsMetric* m=m_hashtable[hash & (METRICS_HASH_BUCKETS-1)]; m != NULL; m=m->m_hashnext)
     {
-    if (strcmp(m->m_name,metric)==0) return m;
+    if (m->m_namehash == hash && strcmp(m->m_name,metric)==0) return m;
     }
   return NULL;
   }
@@ -667,16 +859,177 @@ size_t OvmsMetrics::RegisterModifier()
   return m_nextmodifier++;
   }
 
+void OvmsMetrics::JournalAdd(OvmsMetric* metric)
+  {
+  if (!m_journal)
+    return;
+  uint32_t seq = m_journal_head.fetch_add(1);
+  metric->m_journalseq = seq;
+  metric_journal_entry_t& entry = m_journal[seq & (METRICS_JOURNAL_SIZE-1)];
+  // invalidate the entry while writing, so readers of the old entry notice:
+  entry.seq.store(seq - 1, std::memory_order_release);
+  entry.metric.store(metric, std::memory_order_relaxed);
+  entry.seq.store(seq, std::memory_order_release);
+  }
+
+void OvmsMetrics::JournalRemove(OvmsMetric* metric)
+  {
+  if (!m_journal)
+    return;
+  for (int i = 0; i < METRICS_JOURNAL_SIZE; i++)
+    {
+    OvmsMetric* m = metric;
+    m_journal[i].metric.compare_exchange_strong(m, NULL);
+    }
+  }
+
+OvmsMetricCursor::OvmsMetricCursor()
+  {
+  Reset();
+  }
+
+/**
+ * Reset: restart at the first metric
+ */
+void OvmsMetricCursor::Reset()
+  {
+  m_next = NULL;
+  m_index = 0;
+  m_generation = 0;
+  m_started = false;
+  }
+
+/**
+ * Next: get next metric, or NULL at the end of the list
+ */
+OvmsMetric* OvmsMetricCursor::Next()
+  {
+  uint32_t generation = MyMetrics.m_generation;
+  if (!m_started)
+    {
+    m_next = MyMetrics.m_first;
+    m_index = 0;
+    m_started = true;
+    }
+  else if (generation != m_generation)
+    {
+    // metrics have been removed, m_next may be invalid: find position by index
+    size_t i;
+    for (i = 0, m_next = MyMetrics.m_first; i < m_index && m_next != NULL; m_next = m_next->m_next, i++);
+    }
+  m_generation = generation;
+
+  OvmsMetric* m = m_next;
+  if (m)
+    {
+    m_next = m->m_next;
+    m_index++;
+    }
+  return m;
+  }
+
+OvmsMetricJournalReader::OvmsMetricJournalReader()
+  {
+  m_scanning = false;
+  m_scanfrom = m_scanto = 0;
+  Reset();
+  }
+
+OvmsMetricJournalReader::~OvmsMetricJournalReader()
+  {
+  }
+
+/**
+ * Reset: skip all pending changes
+ */
+void OvmsMetricJournalReader::Reset()
+  {
+  m_seq = MyMetrics.m_journal_head;
+  m_scanning = false;
+  }
+
+/**
+ * StartScan: journal entries from m_seq have been lost, scan the metrics list
+ *  for the lost range and continue reading the journal from the current head
+ */
+void OvmsMetricJournalReader::StartScan()
+  {
+  m_scanfrom = m_seq;
+  m_scanto = m_seq = MyMetrics.m_journal_head;
+  m_scan.Reset();
+  m_scanning = true;
+  ESP_LOGD(TAG, "JournalReader %p: overflow, scanning changes %u..%u", this, m_scanfrom, m_scanto);
+  }
+
+/**
+ * Next: get next changed metric, or NULL if there are no more changes
+ */
+OvmsMetric* OvmsMetricJournalReader::Next()
+  {
+  OvmsMetric* m;
+
+  if (m_scanning)
+    {
+    // Changes after m_scanto will be read from the journal, so the scan
+    //  only needs to report metrics last changed in the lost range:
+    while ((m = m_scan.Next()) != NULL)
+      {
+      if (m->IsDefined() &&
+          (int32_t)(m->m_journalseq - m_scanfrom) >= 0 &&
+          (int32_t)(m->m_journalseq - m_scanto) < 0)
+        return m;
+      }
+    m_scanning = false;
+    }
+
+  if (!MyMetrics.m_journal)
+    return NULL;
+
+  uint32_t head = MyMetrics.m_journal_head;
+  while (m_seq != head)
+    {
+    if (head - m_seq > METRICS_JOURNAL_SIZE)
+      {
+      StartScan();
+      return Next();
+      }
+    metric_journal_entry_t& entry = MyMetrics.m_journal[m_seq & (METRICS_JOURNAL_SIZE-1)];
+    uint32_t seq = entry.seq.load(std::memory_order_acquire);
+    if (seq != m_seq)
+      {
+      if ((int32_t)(seq - m_seq) < 0)
+        return NULL;  // entry is being written, continue on next call
+      StartScan();
+      return Next();
+      }
+    m = entry.metric.load(std::memory_order_relaxed);
+    if (entry.seq.load(std::memory_order_acquire) != seq)
+      {
+      StartScan();
+      return Next();
+      }
+    m_seq++;
+    // skip removed metrics & changes superseded by a later journal entry:
+    if (m && m->m_journalseq == seq)
+      return m;
+    }
+
+  return NULL;
+  }
+
 OvmsMetric::OvmsMetric(const char* name, uint16_t autostale, metric_unit_t units, bool persist)
   {
   m_defined = NeverDefined;
   m_modified = 0;
+  m_journalseq = 0;
   m_name = name;
   m_lastmodified = 0;
   m_autostale = autostale;
   m_stale = false;
   m_units = units;
   m_next = NULL;
+  m_hashnext = NULL;
+  m_namehash = 0;
   m_persist = false;          // only set by metrics supporting persistence
   MyMetrics.RegisterMetric(this);
   }
@@ -755,6 +1108,7 @@ void OvmsMetric::SetModified(bool changed)
   if (changed)
     {
     m_modified = ULONG_MAX;
+    MyMetrics.JournalAdd(this);
     MyMetrics.NotifyModified(this);
     }
   }
@@ -849,6 +1203,17 @@ void OvmsMetric::ClearModified(size_t modifier)
   m_modified &= ~(1ul << modifier);
   }
 
+uint32_t OvmsMetric::GetDeltaSeq()
+  {
+  return 0;
+  }
+
+bool OvmsMetric::AsDeltaJSON(std::string& json, uint32_t& seq, metric_unit_t units, int precision)
+  {
+  seq = 0;
+  return false;
+  }
+
 OvmsMetricInt::OvmsMetricInt(const char* name, uint16_t autostale, metric_unit_t units, bool persist)
   : OvmsMetric(name, autostale, units, persist)
   {
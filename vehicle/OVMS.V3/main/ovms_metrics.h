@@ -34,6 +34,7 @@
 #include <functional>
 #include <map>
 #include <list>
+#include <memory>
 #include <string>
 #include <bitset>
 #include <stdint.h>
@@ -52,6 +53,8 @@
 #define TAG ((const char*)"metric")
 
 #define METRICS_MAX_MODIFIERS 32
+#define METRICS_HASH_BUCKETS  256     // name index size, must be a power of 2
+#define METRICS_JOURNAL_SIZE  512     // change journal entries, must be a power of 2
 
 using namespace std;
 
@@ -173,11 +176,16 @@ class OvmsMetric
     virtual bool IsModifiedAndClear(size_t modifier);
     virtual void ClearModified(size_t modifier);
     virtual void SetModified(bool changed=true);
+    virtual uint32_t GetDeltaSeq();
+    virtual bool AsDeltaJSON(std::string& json, uint32_t& seq, metric_unit_t units = Other, int precision = -1);
 
   public:
     OvmsMetric* m_next;
+    OvmsMetric* m_hashnext;
     const char* m_name;
+    uint32_t m_namehash;
     std::atomic_ulong m_modified;
+    uint32_t m_journalseq;
     uint32_t m_lastmodified;
     uint16_t m_autostale;
     metric_unit_t m_units;
@@ -527,6 +535,10 @@ class OvmsMetricSet : public OvmsMetric
  * Unit conversion currently casts to and from float for the conversion, it's assumed to
  * only be necessary for floating point values here. If you need int conversion, rework
  * UnitConvert() into a template.
+ * 
+ * Element changes are tracked by a change sequence number per element, so consumers
+ * can send only the elements changed since their last transmission (see AsDeltaJSON()).
+ * The consumer keeps the sequence number, start with 0 to get a full update first.
  */
 template
   <
@@ -540,6 +552,8 @@ class OvmsMetricVector : public OvmsMetric
       : OvmsMetric(name, autostale, units, persist)
       {
       m_valuep_size = NULL;
+      m_delta_seq = 0;
+      m_delta_base = 0;
       if (!persist)
         return;
       
@@ -557,6 +571,7 @@ class OvmsMetricVector : public OvmsMetric
       std::size_t psize = *m_valuep_size;
       if (SetPersistSize(psize))
         {
+        DeltaResize(++m_delta_seq);
         SetModified(true);
         ESP_LOGI(TAG, "persist %s = %s", m_name, AsUnitString().c_str());
         }
@@ -623,6 +638,13 @@ class OvmsMetricVector : public OvmsMetric
       return true;
       }
 
+    // Element change tracking, to be called with m_mutex locked:
+    void DeltaResize(uint32_t seq)
+      {
+      m_delta_elem.resize(m_value.size(), seq);
+      m_delta_base = seq;
+      }
+
   public:
     bool CheckPersist()
       {
@@ -722,6 +744,59 @@ class OvmsMetricVector : public OvmsMetric
       return json;
       }
 
+    /**
+     * AsDeltaJSON: get the elements changed since change sequence 'seq'
+     *  - json: array of the vector size followed by index/value pairs, e.g. [96,3,4.012,17,4.009]
+     *    (empty if no element has been changed since 'seq')
+     *  - seq: in = last sequence seen by the consumer, out = current sequence
+     *  - returns false if the consumer needs a full update (AsJSON()) instead, i.e. on
+     *    the first call, after a size change or if the delta would not be much smaller
+     */
+    virtual bool AsDeltaJSON(std::string& json, uint32_t& seq, metric_unit_t units = Other, int precision = -1)
+      {
+      OvmsMutexLock lock(&m_mutex);
+      uint32_t since = seq;
+      seq = m_delta_seq;
+      json.clear();
+      if (!IsDefined() || since == 0 || (int32_t)(since - m_delta_base) < 0)
+        return false;
+      size_t size = m_value.size(), cnt = 0;
+      for (size_t i = 0; i < size; i++)
+        {
+        if ((int32_t)(m_delta_elem[i] - since) > 0)
+          cnt++;
+        }
+      if (cnt == 0)
+        return true;
+      if (cnt > size / 2)
+        return false;
+      std::ostringstream ss;
+      if (precision >= 0)
+        {
+        ss.precision(precision);
+        ss << fixed;
+        }
+      ss << '[' << size;
+      for (size_t i = 0; i < size; i++)
+        {
+        if ((int32_t)(m_delta_elem[i] - since) <= 0)
+          continue;
+        ss << ',' << i << ',';
+        if (units != Other && units != m_units)
+          ss << (ElemType) UnitConvert(m_units, units, (float)m_value[i]);
+        else
+          ss << m_value[i];
+        }
+      ss << ']';
+      json = ss.str();
+      return true;
+      }
+
+    uint32_t GetDeltaSeq()
+      {
+      return m_delta_seq;
+      }
+
 #ifdef CONFIG_OVMS_SC_JAVASCRIPT_DUKTAPE
     void DukPush(DukContext &dc)
       {
@@ -761,11 +836,13 @@ class OvmsMetricVector : public OvmsMetric
       bool modified = false, resized = false;
       if (m_mutex.Lock())
         {
+        uint32_t seq = m_delta_seq + 1;
         if (m_value.size() != value.size())
           {
           m_value.resize(value.size());
           if (m_persist)
             SetPersistSize(value.size());
+          DeltaResize(seq);
           resized = true;
           }
         for (size_t i = 0; i < value.size(); i++)
@@ -778,11 +855,14 @@ class OvmsMetricVector : public OvmsMetric
           if (resized || m_value[i] != ivalue)
             {
             m_value[i] = ivalue;
+            m_delta_elem[i] = seq;
             modified = true;
             if (m_persist)
               *m_valuep_elem[i] = ivalue;
             }
           }
+        if (modified)
+          m_delta_seq = seq;
         m_mutex.Unlock();
         SetModified(modified);
         }
@@ -798,6 +878,7 @@ class OvmsMetricVector : public OvmsMetric
           if (m_persist)
             SetPersistSize(0);
           m_value.clear();
+          DeltaResize(++m_delta_seq);
           m_mutex.Unlock();
           SetModified(true);
           }
@@ -831,16 +912,20 @@ class OvmsMetricVector : public OvmsMetric
       bool modified = false, resized = false;
       if (m_mutex.Lock())
         {
+        uint32_t seq = m_delta_seq + 1;
         if (m_value.size() < n+1)
           {
           m_value.resize(n+1);
           if (m_persist)
             SetPersistSize(n+1);
+          DeltaResize(seq);
           resized = true;
           }
         if (resized || m_value[n] != value)
           {
           m_value[n] = value;
+          m_delta_elem[n] = seq;
+          m_delta_seq = seq;
           modified = true;
           if (m_persist)
             *m_valuep_elem[n] = value;
@@ -855,11 +940,13 @@ class OvmsMetricVector : public OvmsMetric
       bool modified = false, resized = false;
       if (m_mutex.Lock())
         {
+        uint32_t seq = m_delta_seq + 1;
         if (m_value.size() < start+cnt)
           {
           m_value.resize(start+cnt);
           if (m_persist)
             SetPersistSize(start+cnt);
+          DeltaResize(seq);
           resized = true;
           }
         for (size_t i = 0; i < cnt; i++)
@@ -872,11 +959,14 @@ class OvmsMetricVector : public OvmsMetric
           if (resized || m_value[start+i] != ivalue)
             {
             m_value[start+i] = ivalue;
+            m_delta_elem[start+i] = seq;
             modified = true;
             if (m_persist)
               *m_valuep_elem[start+i] = ivalue;
             }
           }
+        if (modified)
+          m_delta_seq = seq;
         m_mutex.Unlock();
         }
       SetModified(modified);
@@ -892,6 +982,85 @@ class OvmsMetricVector : public OvmsMetric
     std::vector<ElemType, Allocator> m_value;
     std::size_t* m_valuep_size;
     std::vector<ElemType*, Allocator> m_valuep_elem;
+    uint32_t m_delta_seq;                     // element change sequence (0 = never changed)
+    uint32_t m_delta_base;                    // sequence of last size change
+    std::vector<uint32_t, typename std::allocator_traits<Allocator>::template rebind_alloc<uint32_t>> m_delta_elem;
+  };
+
+
+/**
+ * The metrics change journal is a ring of the last METRICS_JOURNAL_SIZE metric
+ * changes, written lock free by OvmsMetric::SetModified(). Each entry carries
+ * the global change sequence number it was written for, readers use this to
+ * detect entries in progress or already overwritten.
+ */
+struct metric_journal_entry_t
+  {
+  std::atomic<uint32_t> seq;
+  std::atomic<OvmsMetric*> metric;
+  };
+
+/**
+ * OvmsMetricCursor: resumable position in the (sorted) metrics list
+ *  - use this to iterate over the metrics in multiple steps, e.g. to send
+ *    them in chunks, without walking the list from the start for every step
+ *  - stays valid when metrics are added (metrics added before the cursor
+ *    position will not be visited)
+ *  - if metrics have been removed since the last step, the cursor recovers
+ *    its position by index
+ */
+class OvmsMetricCursor
+  {
+  public:
+    OvmsMetricCursor();
+
+  public:
+    void Reset();
+    OvmsMetric* Next();
+    size_t GetIndex() { return m_index; }
+
+  protected:
+    OvmsMetric* m_next;               // next metric to return
+    size_t m_index;                   // index of m_next in the list
+    uint32_t m_generation;            // list generation m_next is valid for
+    bool m_started;
+  };
+
+/**
+ * OvmsMetricJournalReader: iterate over the metrics changed since the last read
+ *  - reads the change journal from its own cursor, so the work done is
+ *    proportional to the number of changes, not to the number of metrics
+ *  - a metric changed multiple times is returned once (on its latest change)
+ *  - if the reader falls behind by more than METRICS_JOURNAL_SIZE changes,
+ *    it falls back to a full scan of the metrics list for the lost range
+ *  - a reader is not thread safe, use one reader per consumer context
+ *
+ * Usage example:
+ *  OvmsMetricJournalReader reader;
+ *  …
+ *  OvmsMetric* m;
+ *  while ((m = reader.Next()) != NULL)
+ *    Transmit(m);
+ */
+class OvmsMetricJournalReader
+  {
+  public:
+    OvmsMetricJournalReader();
+    virtual ~OvmsMetricJournalReader();
+
+  public:
+    void Reset();
+    OvmsMetric* Next();
+
+  protected:
+    void StartScan();
+
+  protected:
+    uint32_t m_seq;                   // next journal sequence number to read
+    bool m_scanning;                  // fallback scan in progress
+    OvmsMetricCursor m_scan;          // … position in metrics list
+    uint32_t m_scanfrom;              // … report changes from this sequence
+    uint32_t m_scanto;                // … up to (excluding) this sequence
   };
 
 
@@ -927,6 +1096,7 @@ class OvmsMetrics
     bool SetBool(const char* metric, bool value);
     bool SetFloat(const char* metric, float value);
     OvmsMetric* Find(const char* metric);
+    static uint32_t HashName(const char* metric);
 
     OvmsMetricInt *InitInt(const char* metric, uint16_t autostale=0, int value=0, metric_unit_t units = Other, bool persist = false);
     OvmsMetricBool *InitBool(const char* metric, uint16_t autostale=0, bool value=0, metric_unit_t units = Other, bool persist = false);
@@ -971,14 +1141,24 @@ class OvmsMetrics
   public:
     size_t RegisterModifier();
 
+  public:
+    void JournalAdd(OvmsMetric* metric);
+    void JournalRemove(OvmsMetric* metric);
+    metric_journal_entry_t* m_journal;
+    std::atomic<uint32_t> m_journal_head;
+
   public:
     void EventSystemShutDown(std::string event, void* data);
 
   protected:
     size_t m_nextmodifier;
 
+  protected:
+    OvmsMetric* m_hashtable[METRICS_HASH_BUCKETS];
+
   public:
     OvmsMetric* m_first;
+    std::atomic<uint32_t> m_generation;   // incremented on metric removals
     bool m_trace;
   };
 
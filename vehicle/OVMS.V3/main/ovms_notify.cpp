@@ -70,7 +70,10 @@ void notify_status(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc
   for (OvmsNotifyCallbackMap_t::iterator itc=MyNotify.m_readers.begin(); itc!=MyNotify.m_readers.end(); itc++)
     {
     OvmsNotifyCallbackEntry* mc = itc->second;
-    writer->printf("  %s(%d): verbosity=%d\n", mc->m_caller, mc->m_reader, mc->m_verbosity);
+    uint32_t dropped = 0;
+    for (OvmsNotifyTypeMap_t::iterator itm=MyNotify.m_types.begin(); itm!=MyNotify.m_types.end(); ++itm)
+      dropped += itm->second->m_readerdropped[mc->m_reader];
+    writer->printf("  %s(%d): verbosity=%d dropped=%u\n", mc->m_caller, mc->m_reader, mc->m_verbosity, dropped);
     }
 
   if (MyNotify.m_types.size() > 0)
@@ -80,13 +83,14 @@ void notify_status(int verbosity, OvmsWriter* writer, OvmsCommand* cmd, int argc
       {
       OvmsNotifyType* mt = itm->second;
       OvmsRecMutexLock lock(&mt->m_mutex);
-      writer->printf("  %s: %d entries\n",
-        mt->m_name, mt->m_entries.size());
-      for (NotifyEntryMap_t::iterator ite=mt->m_entries.begin(); ite!=mt->m_entries.end(); ++ite)
+      writer->printf("  %s: %d entries, %u bytes, %u dropped\n",
+        mt->m_name, mt->CountEntries(), mt->m_memsize, mt->m_dropped);
+      for (size_t i = 0; i < mt->CountSlots(); i++)
         {
-        OvmsNotifyEntry* e = ite->second;
+        OvmsNotifyEntry* e = mt->GetEntry(i);
+        if (!e) continue;
         writer->printf("    %d: [%d pending] %s\n",
-          ite->first, e->CountPending(), e->GetValue().c_str());
+          e->m_id, e->CountPending(), e->GetValue().c_str());
         }
       }
     }
@@ -160,6 +164,7 @@ static duk_ret_t DukOvmsNotifyRaise(duk_context *ctx)
 OvmsNotifyEntry::OvmsNotifyEntry(const char* subtype)
   {
   m_pendingreaders = 0;
+  m_heldreaders = 0;
   m_id = 0;
   m_created = esp_log_timestamp();
   m_type = NULL;
@@ -198,6 +203,12 @@ const extram::string OvmsNotifyEntry::GetValue()
   return extram::string("");
   }
 
+size_t OvmsNotifyEntry::GetMemSize()
+  {
+  // approximation, used for the queue memory limit:
+  return sizeof(OvmsNotifyEntryString) + strlen(m_subtype) + 1 + GetValueSize();
+  }
+
 const char* OvmsNotifyEntry::GetSubType()
   {
   return m_subtype;
@@ -264,6 +275,17 @@ OvmsNotifyType::OvmsNotifyType(const char* name)
   {
   m_name = name;
   m_nextid = 1;
+  m_ring.resize(NOTIFY_QUEUE_MINSLOTS);
+  m_head = 0;
+  m_used = 0;
+  m_count = 0;
+  m_memsize = 0;
+  m_dropped = 0;
+  for (int i=0; i<NOTIFY_MAX_READERS; i++)
+    {
+    m_cursor[i] = 1;
+    m_readerdropped[i] = 0;
+    }
   }
 
 OvmsNotifyType::~OvmsNotifyType()
@@ -275,9 +297,17 @@ uint32_t OvmsNotifyType::QueueEntry(OvmsNotifyEntry* entry)
   OvmsRecMutexLock lock(&m_mutex);
   uint32_t id = m_nextid++;
 
+  // Ring full: compact if at least half of the slots are free, else grow
+  if (m_used == m_ring.size())
+    Resize((m_count <= m_ring.size() / 2) ? m_ring.size() : m_ring.size() * 2);
+
   entry->m_id = id;
   entry->m_type = this;
-  m_entries[id] = entry;
+  OvmsNotifySlot_t& slot = Slot(m_used++);
+  slot.id = id;
+  slot.entry = entry;
+  m_count++;
+  m_memsize += entry->GetMemSize();
 
   if (strcmp(m_name, "data") != 0 &&
       strcmp(m_name, "stream") != 0)
@@ -295,6 +325,9 @@ uint32_t OvmsNotifyType::QueueEntry(OvmsNotifyEntry* entry)
   // Check if we can cleanup...
   Cleanup(entry);
 
+  // Apply memory limit...
+  Limit();
+
   return id;
   }
 
@@ -304,65 +337,183 @@ uint32_t OvmsNotifyType::AllocateNextID()
   return m_nextid++;
   }
 
+/**
+ * Lookup: get the index of the first slot with an ID >= id (m_used if none)
+ */
+size_t OvmsNotifyType::Lookup(uint32_t id)
+  {
+  size_t lo = 0, hi = m_used;
+  while (lo < hi)
+    {
+    size_t mid = (lo + hi) / 2;
+    if (Slot(mid).id < id)
+      lo = mid + 1;
+    else
+      hi = mid;
+    }
+  return lo;
+  }
+
+/**
+ * Resize: reallocate the ring, dropping the slots of removed entries
+ */
+void OvmsNotifyType::Resize(size_t slots)
+  {
+  NotifyEntryRing_t ring(slots);
+  size_t used = 0;
+  for (size_t i = 0; i < m_used; i++)
+    {
+    OvmsNotifySlot_t& slot = Slot(i);
+    if (slot.entry)
+      ring[used++] = slot;
+    }
+  m_ring.swap(ring);
+  m_head = 0;
+  m_used = used;
+  }
+
+/**
+ * Remove: free the entry at slot index
+ *  Note: this may compact the ring, so indexes are invalid after the call.
+ */
+void OvmsNotifyType::Remove(size_t index)
+  {
+  OvmsNotifySlot_t& slot = Slot(index);
+  OvmsNotifyEntry* entry = slot.entry;
+  slot.entry = NULL;
+  m_count--;
+  m_memsize -= entry->GetMemSize();
+  delete entry;
+
+  // Release free slots at the ring ends, shrink the ring if mostly unused:
+  while (m_used > 0 && Slot(0).entry == NULL)
+    {
+    m_head = (m_head + 1) & (m_ring.size()-1);
+    m_used--;
+    }
+  while (m_used > 0 && Slot(m_used-1).entry == NULL)
+    m_used--;
+  if (m_ring.size() > NOTIFY_QUEUE_MINSLOTS && m_used < m_ring.size() / 4)
+    Resize(m_ring.size() / 2);
+  }
+
 void OvmsNotifyType::ClearReader(size_t reader)
   {
   OvmsRecMutexLock lock(&m_mutex);
-  if (m_entries.size() > 0)
+  unsigned long mask = ~(1ul << reader);
+  for (size_t i = 0; i < m_used; )
     {
-    NotifyEntryMap_t::iterator next;
-    for (NotifyEntryMap_t::iterator ite=m_entries.begin(); ite!=m_entries.end(); )
+    OvmsNotifyEntry* e = Slot(i).entry;
+    if (e)
       {
-      OvmsNotifyEntry* e = ite->second;
-      ++ite;
-      e->m_pendingreaders &= ~(1ul << reader);
-      Cleanup(e, &ite);
+      e->m_pendingreaders &= mask;
+      e->m_heldreaders &= mask;
+      if (e->IsAllRead())
+        {
+        uint32_t id = e->m_id;
+        Cleanup(e);
+        i = Lookup(id);       // the ring may have been compacted
+        continue;
+        }
       }
+    i++;
     }
+  m_cursor[reader] = m_nextid;
+  m_readerdropped[reader] = 0;
   }
 
 OvmsNotifyEntry* OvmsNotifyType::FirstUnreadEntry(size_t reader, uint32_t floor)
   {
   OvmsRecMutexLock lock(&m_mutex);
-  for (NotifyEntryMap_t::iterator ite=m_entries.begin(); ite!=m_entries.end(); ++ite)
+
+  // IDs below the cursor have been read, so the cursor is only advanced
+  // if the scan starts there (i.e. floor is below the cursor):
+  uint32_t& cursor = m_cursor[reader];
+  bool advance = (floor < cursor);
+  for (size_t i = Lookup(advance ? cursor : floor + 1); i < m_used; i++)
     {
-    OvmsNotifyEntry* e = ite->second;
-    if ((!e->IsRead(reader))&&(e->m_id > floor))
+    OvmsNotifyEntry* e = Slot(i).entry;
+    if (e && !e->IsRead(reader))
+      {
+      if (advance) cursor = e->m_id;
+      e->Hold(reader);
       return e;
+      }
     }
+  if (advance) cursor = m_nextid;
   return NULL;
   }
 
 OvmsNotifyEntry* OvmsNotifyType::FindEntry(uint32_t id)
   {
   OvmsRecMutexLock lock(&m_mutex);
-  auto k = m_entries.find(id);
-  if (k == m_entries.end())
-    return NULL;
+  size_t i = Lookup(id);
+  if (i < m_used && Slot(i).id == id)
+    return Slot(i).entry;
   else
-    return k->second;
+    return NULL;
   }
 
 void OvmsNotifyType::MarkRead(size_t reader, OvmsNotifyEntry* entry)
   {
   OvmsRecMutexLock lock(&m_mutex);
   entry->m_pendingreaders &= ~(1ul << reader);
+  entry->m_heldreaders &= ~(1ul << reader);
   Cleanup(entry);
   }
 
-void OvmsNotifyType::Cleanup(OvmsNotifyEntry* entry, NotifyEntryMap_t::iterator* next /*=NULL*/)
+void OvmsNotifyType::Cleanup(OvmsNotifyEntry* entry)
   {
   if (entry->IsAllRead())
     {
     // We can cleanup...
-    auto k = m_entries.find(entry->m_id);
-    if (k != m_entries.end())
+    if (MyNotify.m_trace && strcmp(m_name, "stream") != 0)
+      ESP_LOGI(TAG,"Cleanup type %s id %d",m_name,entry->m_id);
+    size_t i = Lookup(entry->m_id);
+    if (i < m_used && Slot(i).entry == entry)
+      Remove(i);
+    else
+      delete entry;
+    }
+  }
+
+/**
+ * Limit: drop oldest entries while exceeding the memory limit
+ *  Entries held by a reader (i.e. in transmission) are kept.
+ */
+void OvmsNotifyType::Limit()
+  {
+  int maxsize = m_maxsize;
+  if (maxsize <= 0)
+    return;
+  size_t limit = maxsize * 1024;
+  while (m_count > 0 && m_memsize + m_ring.size() * sizeof(OvmsNotifySlot_t) > limit)
+    {
+    // find oldest entry not held:
+    size_t i;
+    OvmsNotifyEntry* e = NULL;
+    for (i = 0; i < m_used; i++)
+      {
+      e = Slot(i).entry;
+      if (e && e->m_heldreaders == 0)
+        break;
+      }
+    if (i == m_used)
+      break;
+
+    // count drops:
+    m_dropped++;
+    unsigned long pend = e->m_pendingreaders;
+    for (int r=0; r<NOTIFY_MAX_READERS && pend; r++, pend >>= 1)
       {
-      NotifyEntryMap_t::iterator it = m_entries.erase(k);
-      if (next) *next = it;
+      if (pend & 1) m_readerdropped[r]++;
       }
     if (MyNotify.m_trace && strcmp(m_name, "stream") != 0)
-      ESP_LOGI(TAG,"Cleanup type %s id %d",m_name,entry->m_id);
-    delete entry;
+      ESP_LOGW(TAG,"Queue full: dropped type %s id %d",m_name,e->m_id);
+    else
+      ESP_LOGD(TAG,"Queue full: dropped type %s id %d",m_name,e->m_id);
+
+    Remove(i);
     }
   }
 
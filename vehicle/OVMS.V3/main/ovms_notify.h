@@ -37,12 +37,16 @@
 #include <string>
 #include <bitset>
 #include <atomic>
+#include <vector>
 #include <stdint.h>
 #include "ovms.h"
 #include "ovms_utils.h"
 #include "ovms_mutex.h"
+#include "ovms_config.h"
 
 #define NOTIFY_MAX_READERS 32
+#define NOTIFY_QUEUE_MINSLOTS 16        // Initial ring size per type
+#define NOTIFY_QUEUE_MAXSIZE 128        // Default memory limit per type [kB] (config notify queue.maxsize)
 #define NOTIFY_ERROR_AUTOSUPPRESS 120 // Auto-suppress for 120 seconds
 
 using namespace std;
@@ -63,9 +67,12 @@ class OvmsNotifyEntry : public ExternalRamAllocated
     virtual bool IsAllRead();
     virtual OvmsNotifyType* GetType() { return m_type; }
     virtual const char* GetSubType();
+    void Hold(size_t reader) { m_heldreaders |= (1ul << reader); }
+    size_t GetMemSize();
 
   public:
     std::atomic_ulong m_pendingreaders;
+    std::atomic_ulong m_heldreaders;    // readers keeping a reference (entry will not be dropped)
     uint32_t m_id;
     uint32_t m_created;
     OvmsNotifyType* m_type;
@@ -101,9 +108,23 @@ class OvmsNotifyEntryCommand : public OvmsNotifyEntry
      extram::string m_value;
   };
 
-typedef std::map<uint32_t, OvmsNotifyEntry*, std::less<uint32_t>,
-  ExtRamAllocator<std::pair<const uint32_t, OvmsNotifyEntry*>>> NotifyEntryMap_t;
-
+typedef struct
+  {
+  uint32_t id;
+  OvmsNotifyEntry* entry;                     // NULL = removed
+  } OvmsNotifySlot_t;
+
+typedef std::vector<OvmsNotifySlot_t, ExtRamAllocator<OvmsNotifySlot_t>> NotifyEntryRing_t;
+
+/**
+ * OvmsNotifyType: notification queue
+ *  Entries are kept in ID order in a ring buffer, lookups by ID are binary searches.
+ *  Slots of entries removed out of order are compacted on the next ring wrap.
+ *  Readers fetching entries by FirstUnreadEntry() keep a cursor (the lowest ID
+ *  possibly unread), so they don't need to rescan entries already read.
+ *  The queue memory is limited by config "notify queue.maxsize" [kB], on overflow
+ *  the oldest entries not held by a reader are dropped.
+ */
 class OvmsNotifyType
   {
   public:
@@ -117,14 +138,30 @@ class OvmsNotifyType
     OvmsNotifyEntry* FirstUnreadEntry(size_t reader, uint32_t floor);
     OvmsNotifyEntry* FindEntry(uint32_t id);
     void MarkRead(size_t reader, OvmsNotifyEntry* entry);
+    size_t CountEntries() { return m_count; }
+    OvmsNotifyEntry* GetEntry(size_t index) { return (index < m_used) ? Slot(index).entry : NULL; }
+    size_t CountSlots() { return m_used; }
 
   protected:
-    void Cleanup(OvmsNotifyEntry* entry, NotifyEntryMap_t::iterator* next=NULL);
+    OvmsNotifySlot_t& Slot(size_t index) { return m_ring[(m_head + index) & (m_ring.size()-1)]; }
+    size_t Lookup(uint32_t id);
+    void Resize(size_t slots);
+    void Remove(size_t index);
+    void Cleanup(OvmsNotifyEntry* entry);
+    void Limit();
 
   public:
     const char* m_name;
     uint32_t m_nextid;
-    NotifyEntryMap_t m_entries;
+    NotifyEntryRing_t m_ring;                   // size = power of 2
+    size_t m_head;                              // ring index of oldest slot
+    size_t m_used;                              // slots used (incl. removed)
+    size_t m_count;                             // entries queued
+    size_t m_memsize;                           // memory used by entries queued
+    uint32_t m_cursor[NOTIFY_MAX_READERS];      // per reader: lowest ID possibly unread
+    uint32_t m_dropped;                         // entries dropped by memory limit
+    uint32_t m_readerdropped[NOTIFY_MAX_READERS]; // … per reader
+    ConfigRef<int> m_maxsize { "notify", "queue.maxsize", NOTIFY_QUEUE_MAXSIZE };
     OvmsRecMutex m_mutex;
   };
 
@@ -139,9 +139,10 @@ OvmsTime::OvmsTime()
   #undef bind  // Kludgy, but works
   using std::placeholders::_1;
   using std::placeholders::_2;
+  using std::placeholders::_3;
   MyEvents.RegisterEvent(TAG,"system.start", std::bind(&OvmsTime::EventSystemStart, this, _1, _2));
   MyEvents.RegisterEvent(TAG,"config.changed", std::bind(&OvmsTime::EventConfigChanged, this, _1, _2));
-  MyEvents.RegisterEvent(TAG,"ticker.60", std::bind(&OvmsTime::EventTicker60, this, _1, _2));
+  MyEvents.RegisterEventId(TAG,"ticker.60", std::bind(&OvmsTime::EventTicker60, this, _1, _2, _3));
   MyEvents.RegisterEvent(TAG,"network.up", std::bind(&OvmsTime::EventNetUp, this, _1, _2));
   MyEvents.RegisterEvent(TAG,"network.down", std::bind(&OvmsTime::EventNetDown, this, _1, _2));
   MyEvents.RegisterEvent(TAG,"network.reconfigured", std::bind(&OvmsTime::EventNetReconfigured, this, _1, _2));
@@ -170,7 +171,7 @@ void OvmsTime::EventSystemStart(std::string event, void* data)
   tzset();
   }
 
-void OvmsTime::EventTicker60(std::string event, void* data)
+void OvmsTime::EventTicker60(event_id_t id, const char* event, void* data)
   {
   // Refresh SNTP, if possible
   if (sntp_enabled() && MyNetManager.m_connected_any)
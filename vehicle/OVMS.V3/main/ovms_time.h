@@ -37,6 +37,7 @@
 #include <map>
 #include <string>
 #include "ovms_utils.h"
+#include "ovms_events.h"
 
 using namespace std;
 
@@ -76,7 +77,7 @@ class OvmsTime
   public:
     void EventConfigChanged(std::string event, void* data);
     void EventSystemStart(std::string event, void* data);
-    void EventTicker60(std::string event, void* data);
+    void EventTicker60(event_id_t id, const char* event, void* data);
     void EventNetUp(std::string event, void* data);
     void EventNetDown(std::string event, void* data);
     void EventNetReconfigured(std::string event, void* data);